@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "application.hpp"
+
+using namespace std;
+
+// usage: Command.Exercise_application_benchmark [command_count]
+//  - the same script is run through the previous run loop, Application::run() & Application::run_batch()
+
+namespace
+{
+    const string script_filename = "application_benchmark_script.txt";
+
+    // the previous run loop - an upper-cased copy of every command is looked up in the map
+    class PreviousApplication
+    {
+        Console& console_;
+        unordered_map<string, CommandSharedPtr> cmds_;
+
+        static void to_upper(string& text)
+        {
+            transform(text.begin(), text.end(), text.begin(), [](auto c) { return toupper(c); });
+        }
+
+    public:
+        PreviousApplication(Console& console)
+            : console_{console}
+        {
+        }
+
+        void run()
+        {
+            while (true)
+            {
+                console_.print(Messages::msg_prompt);
+
+                auto cmd = console_.get_line();
+                to_upper(cmd);
+
+                if (cmd == Commands::cmd_exit)
+                    break;
+
+                if (auto pos = cmds_.find(cmd); pos != cmds_.end())
+                    pos->second->execute();
+                else
+                    console_.print(Messages::msg_unknown_cmd + cmd);
+            }
+        }
+
+        void add_command(string name, CommandSharedPtr cmd)
+        {
+            to_upper(name);
+            cmds_.emplace(move(name), cmd);
+        }
+    };
+
+    // reads & prints a line at a time - flush_each_line mimics the previous Terminal (std::endl)
+    class LineConsole : public Console
+    {
+        istream& in_;
+        ostream& out_;
+        bool flush_each_line_;
+        bool is_end_of_input_ = false;
+
+    public:
+        LineConsole(istream& in, ostream& out, bool flush_each_line)
+            : in_{in}
+            , out_{out}
+            , flush_each_line_{flush_each_line}
+        {
+        }
+
+        string get_line() override
+        {
+            string line;
+            is_end_of_input_ = !getline(in_, line);
+
+            return line;
+        }
+
+        void print(const string& line) override
+        {
+            out_ << line << '\n';
+
+            if (flush_each_line_)
+                out_.flush();
+        }
+
+        bool is_end_of_input() const override
+        {
+            return is_end_of_input_;
+        }
+
+        void flush() override
+        {
+            out_.flush();
+        }
+    };
+
+    void generate_script(size_t command_count)
+    {
+        ofstream script{script_filename, ios::binary};
+
+        for (size_t i = 0; i < command_count; ++i)
+        {
+            switch (i % 4)
+            {
+            case 0:
+                script << "addText\nabc\n";
+                break;
+            case 1:
+                script << "PASTE\n";
+                break;
+            case 2:
+                script << "undo\n";
+                break;
+            default:
+                script << "Print\n";
+            }
+        }
+
+        script << "Exit\n";
+    }
+
+    struct Result
+    {
+        double time;
+        string text;
+    };
+
+    template <typename TApplication, typename TConsole, typename TRun>
+    Result run_script(TConsole& console, TRun run)
+    {
+        Document doc;
+        SharedClipboard clipboard;
+        CommandHistory history;
+
+        TApplication app{console};
+        app.add_command("Print", make_shared<PrintCmd>(doc, console));
+        app.add_command("ToUpper", make_shared<ToUpperCmd>(doc, history));
+        app.add_command("Clear", make_shared<ClearCmd>(doc, history));
+        app.add_command("AddText", make_shared<AddTextCmd>(doc, console, history));
+        app.add_command("Paste", make_shared<PasteCmd>(doc, clipboard, history));
+        app.add_command("Undo", make_shared<UndoCmd>(console, history));
+
+        auto start = chrono::steady_clock::now();
+        run(app);
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        return Result{elapsed, doc.text()};
+    }
+
+    void print_result(const string& name, const Result& result, size_t command_count, double baseline_time)
+    {
+        cout << name
+             << "\ttime: " << result.time << " s"
+             << "\tcommands/s: " << static_cast<size_t>(command_count / result.time)
+             << "\tspeedup: " << baseline_time / result.time << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t command_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+
+    cout << "Generating a script of " << command_count << " commands..." << endl;
+    generate_script(command_count);
+
+    const string previous_output = "application_benchmark_previous.txt";
+    const string interactive_output = "application_benchmark_interactive.txt";
+    const string batch_output = "application_benchmark_batch.txt";
+
+    Result previous;
+    {
+        ifstream in{script_filename, ios::binary};
+        ofstream out{previous_output, ios::binary};
+        LineConsole console{in, out, true};
+        previous = run_script<PreviousApplication>(console, [](auto& app) { app.run(); });
+    }
+
+    Result interactive;
+    {
+        ifstream in{script_filename, ios::binary};
+        ofstream out{interactive_output, ios::binary};
+        LineConsole console{in, out, false};
+        interactive = run_script<Application>(console, [](auto& app) { app.run(); });
+    }
+
+    Result batch;
+    {
+        ifstream in{script_filename, ios::binary};
+        ofstream out{batch_output, ios::binary};
+        BatchConsole console{in, out};
+        batch = run_script<Application>(console, [](auto& app) { app.run_batch(); });
+    }
+
+    print_result("previous run loop (std::endl)", previous, command_count, previous.time);
+    print_result("interactive run()            ", interactive, command_count, previous.time);
+    print_result("batch run_batch()            ", batch, command_count, previous.time);
+
+    auto file_content = [](const string& filename) {
+        ifstream file{filename, ios::binary};
+        return string{istreambuf_iterator<char>{file}, istreambuf_iterator<char>{}};
+    };
+
+    const bool is_consistent = previous.text == interactive.text && interactive.text == batch.text
+        && file_content(previous_output) == file_content(interactive_output);
+
+    cout << "results consistent: " << boolalpha << is_consistent << endl;
+
+    for (const auto& filename : {script_filename, previous_output, interactive_output, batch_output})
+        remove(filename.c_str());
+
+    return is_consistent ? 0 : 1;
+}
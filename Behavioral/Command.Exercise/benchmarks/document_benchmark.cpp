@@ -0,0 +1,119 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "document.hpp"
+
+using namespace std;
+
+// usage: Command.Exercise_document_benchmark [edit_count] [max_size_mb]
+//  - documents of 1, 10, 100... MB up to max_size_mb are edited at random positions
+
+namespace
+{
+    // the previous backend - a single std::string edited in place
+    class StringDocument
+    {
+        string text_;
+
+    public:
+        explicit StringDocument(string text)
+            : text_{move(text)}
+        {
+        }
+
+        size_t length() const
+        {
+            return text_.size();
+        }
+
+        void insert(size_t pos, const string& text)
+        {
+            text_.insert(pos, text);
+        }
+
+        void erase(size_t pos, size_t count)
+        {
+            text_.erase(pos, count);
+        }
+
+        string text() const
+        {
+            return text_;
+        }
+    };
+
+    struct Edit
+    {
+        bool is_insert;
+        double position; // fraction of the current length
+        string text;
+    };
+
+    vector<Edit> generate_edits(size_t edit_count)
+    {
+        mt19937 rnd{42};
+        uniform_real_distribution<double> position{0.0, 1.0};
+        uniform_int_distribution<int> letter{'a', 'z'};
+
+        vector<Edit> edits;
+        edits.reserve(edit_count);
+
+        for (size_t i = 0; i < edit_count; ++i)
+            edits.push_back(Edit{i % 3 != 2, position(rnd), string(1 + i % 16, static_cast<char>(letter(rnd)))});
+
+        return edits;
+    }
+
+    template <typename TDocument>
+    double run_edits(TDocument& doc, const vector<Edit>& edits)
+    {
+        auto start = chrono::steady_clock::now();
+
+        for (const auto& edit : edits)
+        {
+            const auto pos = static_cast<size_t>(edit.position * doc.length());
+
+            if (edit.is_insert)
+                doc.insert(pos, edit.text);
+            else
+                doc.erase(pos, edit.text.size());
+        }
+
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t edit_count = argc > 1 ? stoul(argv[1]) : 10'000;
+    const size_t max_size_mb = argc > 2 ? stoul(argv[2]) : 100;
+
+    const auto edits = generate_edits(edit_count);
+
+    bool is_consistent = true;
+
+    for (size_t size_mb = 1; size_mb <= max_size_mb; size_mb *= 10)
+    {
+        const string initial_text(size_mb * 1024 * 1024, 'x');
+
+        StringDocument string_doc{initial_text};
+        const double string_time = run_edits(string_doc, edits);
+
+        Document piece_table_doc{initial_text};
+        const double piece_table_time = run_edits(piece_table_doc, edits);
+
+        is_consistent = is_consistent && piece_table_doc.text() == string_doc.text();
+
+        cout << "size: " << size_mb << " MB"
+             << "\tstd::string: " << static_cast<size_t>(edits.size() / string_time) << " edits/s"
+             << "\tpiece table: " << static_cast<size_t>(edits.size() / piece_table_time) << " edits/s"
+             << "\tspeedup: " << string_time / piece_table_time << endl;
+    }
+
+    cout << "results consistent: " << boolalpha << is_consistent << endl;
+
+    return is_consistent ? 0 : 1;
+}
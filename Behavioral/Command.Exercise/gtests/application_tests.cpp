@@ -4,6 +4,8 @@
 #include "mocks/mock_command.hpp"
 #include "mocks/mock_console.hpp"
 #include <memory>
+#include <optional>
+#include <type_traits>
 
 using namespace ::testing;
 
@@ -78,3 +80,68 @@ TEST_F(ApplicationTests_MainLoop, UnknownCommandPrintsErrorMesssage)
     
     app.run();
 }
+
+TEST_F(ApplicationTests_MainLoop, CommandNamesAreCaseInsensitive)
+{
+    EXPECT_CALL(*mq_cmd, execute()).Times(2);
+    EXPECT_CALL(mq_console, get_line())
+        .WillOnce(Return("CMD"))
+        .WillOnce(Return("Cmd"))
+        .WillOnce(Return("exit"));
+
+    app.run();
+}
+
+TEST_F(ApplicationTests_MainLoop, EndOfInputBreaksALoop)
+{
+    EXPECT_CALL(mq_console, get_line()).WillOnce(Return(""));
+    EXPECT_CALL(mq_console, is_end_of_input()).WillOnce(Return(true));
+
+    app.run();
+}
+
+struct ApplicationTests_Batch : ApplicationTests_MainLoop
+{
+};
+
+TEST_F(ApplicationTests_Batch, ExecutesCommandsWithoutPrompts)
+{
+    EXPECT_CALL(mq_console, print(Messages::msg_prompt)).Times(0);
+    EXPECT_CALL(*mq_cmd, execute()).Times(2);
+    EXPECT_CALL(mq_console, is_end_of_input())
+        .WillOnce(Return(false))
+        .WillOnce(Return(false))
+        .WillOnce(Return(true));
+    EXPECT_CALL(mq_console, get_line()).WillRepeatedly(Return("cmd"));
+
+    app.run_batch();
+}
+
+TEST_F(ApplicationTests_Batch, OutputIsFlushedAtTheEnd)
+{
+    EXPECT_CALL(mq_console, get_line()).WillOnce(Return(Commands::cmd_exit));
+    EXPECT_CALL(mq_console, flush()).Times(1);
+
+    app.run_batch();
+}
+
+TEST(ApplicationTests_Move, MovedApplicationFindsItsCommands)
+{
+    static_assert(!std::is_copy_constructible_v<Application>);
+
+    NiceMock<MockConsole> mq_console;
+    auto mq_cmd = std::make_shared<NiceMock<MockCommand>>();
+
+    std::optional<Application> source{std::in_place, mq_console};
+    source->add_command("cmd", mq_cmd);
+
+    Application app{std::move(*source)};
+    source.reset();
+
+    EXPECT_CALL(*mq_cmd, execute());
+    EXPECT_CALL(mq_console, get_line())
+        .WillOnce(Return("cmd"))
+        .WillOnce(Return(Commands::cmd_exit));
+
+    app.run();
+}
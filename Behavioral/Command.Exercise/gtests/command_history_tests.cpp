@@ -0,0 +1,176 @@
+#include <memory>
+#include <stdexcept>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "command.hpp"
+#include "mocks/mock_clipboard.hpp"
+
+using namespace ::testing;
+
+namespace
+{
+    class FakeCmd : public CloneableCommand<FakeCmd>
+    {
+    public:
+        int id;
+        size_t bytes;
+
+        FakeCmd(int id, size_t bytes = 0)
+            : id{id}
+            , bytes{bytes}
+        {
+        }
+
+        void execute() override
+        {
+        }
+
+        void undo() override
+        {
+        }
+
+        size_t retained_bytes() const override
+        {
+            return bytes;
+        }
+    };
+
+    int id_of(const UndoableCommandPtr& cmd)
+    {
+        return static_cast<const FakeCmd&>(*cmd).id;
+    }
+}
+
+struct CommandHistory_Limits : Test
+{
+    CommandHistory history{HistoryLimits{3, 100}};
+};
+
+TEST_F(CommandHistory_Limits, OldestEntriesAreEvictedAboveMaxEntries)
+{
+    for (int id = 1; id <= 5; ++id)
+        history.record_last_command(std::make_unique<FakeCmd>(id));
+
+    ASSERT_THAT(history.stats().entries, Eq(3));
+    ASSERT_THAT(history.stats().evictions, Eq(2));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(5));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(4));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(3));
+    ASSERT_THROW(history.pop_last_command(), std::out_of_range);
+}
+
+TEST_F(CommandHistory_Limits, OldestEntriesAreEvictedAboveMaxBytes)
+{
+    history.record_last_command(std::make_unique<FakeCmd>(1, 40));
+    history.record_last_command(std::make_unique<FakeCmd>(2, 40));
+    history.record_last_command(std::make_unique<FakeCmd>(3, 40));
+
+    ASSERT_THAT(history.retained_bytes_per_entry(), ElementsAre(40, 40));
+    ASSERT_THAT(history.stats().retained_bytes, Eq(80));
+    ASSERT_THAT(history.stats().evictions, Eq(1));
+}
+
+TEST_F(CommandHistory_Limits, LastCommandIsKeptAboveMaxBytes)
+{
+    history.record_last_command(std::make_unique<FakeCmd>(1, 10));
+    history.record_last_command(std::make_unique<FakeCmd>(2, 1000));
+
+    ASSERT_THAT(history.size(), Eq(1));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(2));
+    ASSERT_THAT(history.stats().retained_bytes, Eq(0));
+}
+
+TEST_F(CommandHistory_Limits, OrderIsKeptWhenRingWrapsAfterUndo)
+{
+    for (int id = 1; id <= 4; ++id)
+        history.record_last_command(std::make_unique<FakeCmd>(id));
+
+    history.pop_last_command();
+    history.record_last_command(std::make_unique<FakeCmd>(5));
+    history.record_last_command(std::make_unique<FakeCmd>(6));
+
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(6));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(5));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(3));
+}
+
+TEST_F(CommandHistory_Limits, OrderIsKeptWhenRingGrowsAfterEviction)
+{
+    history.record_last_command(std::make_unique<FakeCmd>(1, 60));
+    history.record_last_command(std::make_unique<FakeCmd>(2, 60));
+    history.record_last_command(std::make_unique<FakeCmd>(3));
+    history.record_last_command(std::make_unique<FakeCmd>(4));
+
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(4));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(3));
+    ASSERT_THAT(id_of(history.pop_last_command()), Eq(2));
+}
+
+TEST(CommandHistory_ZeroEntries, Throws)
+{
+    ASSERT_THROW(CommandHistory{HistoryLimits{0}}, std::invalid_argument);
+}
+
+//-----------------------------------------------------------------
+
+struct CommandHistory_Coalescing : Test
+{
+    Document doc{"abc"};
+    NiceMock<MockClipboard> mq_clipboard;
+    CommandHistory history;
+    PasteCmd paste_cmd{doc, mq_clipboard, history};
+
+    void SetUp() override
+    {
+        ON_CALL(mq_clipboard, content()).WillByDefault(Return("def"));
+    }
+};
+
+TEST_F(CommandHistory_Coalescing, AdjacentAppendsAreUndoneInOneStep)
+{
+    paste_cmd.execute();
+    paste_cmd.execute();
+    paste_cmd.execute();
+
+    ASSERT_THAT(history.size(), Eq(1));
+    ASSERT_THAT(history.stats().coalesced_commands, Eq(2));
+
+    history.pop_last_command()->undo();
+
+    ASSERT_THAT(doc.text(), StrEq("abc"));
+}
+
+TEST_F(CommandHistory_Coalescing, AppendsSeparatedByOtherEditsAreNotMerged)
+{
+    ToUpperCmd to_upper_cmd{doc, history};
+
+    paste_cmd.execute();
+    to_upper_cmd.execute();
+    paste_cmd.execute();
+
+    ASSERT_THAT(history.size(), Eq(3));
+
+    history.pop_last_command()->undo();
+
+    ASSERT_THAT(doc.text(), StrEq("ABCDEF"));
+}
+
+TEST(CommandHistory_CoalescingDisabled, EveryAppendIsAnUndoStep)
+{
+    Document doc;
+    NiceMock<MockClipboard> mq_clipboard;
+    ON_CALL(mq_clipboard, content()).WillByDefault(Return("x"));
+
+    HistoryLimits limits;
+    limits.coalesce_edits = false;
+    CommandHistory history{limits};
+    PasteCmd paste_cmd{doc, mq_clipboard, history};
+
+    paste_cmd.execute();
+    paste_cmd.execute();
+
+    ASSERT_THAT(history.size(), Eq(2));
+    ASSERT_THAT(history.stats().coalesced_commands, Eq(0));
+}
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "command.hpp"
+
+using namespace ::testing;
+
+// operator new and operator delete are replaced for the whole test program - only the calls
+// between the start and the end of a measured block are checked
+namespace
+{
+    size_t new_calls = 0;
+    const void* watched_block = nullptr; // a block whose release is checked by a test
+    size_t watched_block_delete_calls = 0;
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        ++new_calls;
+
+        const std::size_t rounded_size = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+
+        if (void* raw_mem = std::aligned_alloc(alignment, rounded_size))
+            return raw_mem;
+
+        throw std::bad_alloc{};
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, std::max(static_cast<std::size_t>(alignment), sizeof(void*)));
+}
+
+// memory of the replaced operator new comes from aligned_alloc, so it is released with free -
+// GCC cannot see that when the delete is inlined next to a new expression
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace
+{
+    void deallocate(void* raw_mem) noexcept
+    {
+        if (raw_mem && raw_mem == watched_block)
+            ++watched_block_delete_calls;
+
+        std::free(raw_mem);
+    }
+}
+
+void operator delete(void* raw_mem) noexcept
+{
+    deallocate(raw_mem);
+}
+
+void operator delete(void* raw_mem, std::size_t) noexcept
+{
+    deallocate(raw_mem);
+}
+
+void operator delete(void* raw_mem, std::align_val_t) noexcept
+{
+    deallocate(raw_mem);
+}
+
+void operator delete(void* raw_mem, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(raw_mem);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+    class FixedClipboard : public Clipboard
+    {
+        std::string content_;
+
+    public:
+        explicit FixedClipboard(std::string content)
+            : content_{std::move(content)}
+        {
+        }
+
+        std::string content() const override
+        {
+            return content_;
+        }
+
+        void set_content(const std::string& content) override
+        {
+            content_ = content;
+        }
+    };
+
+    class SilentConsole : public Console
+    {
+    public:
+        std::string get_line() override
+        {
+            return {};
+        }
+
+        void print(const std::string&) override
+        {
+        }
+    };
+
+    HistoryLimits without_coalescing(size_t max_entries)
+    {
+        HistoryLimits limits;
+        limits.max_entries = max_entries;
+        limits.coalesce_edits = false;
+
+        return limits;
+    }
+}
+
+struct CommandPool_SteadyState : Test
+{
+    Document doc{"abc"};
+    SilentConsole console;
+};
+
+TEST_F(CommandPool_SteadyState, PasteAndUndoDoNotAllocate)
+{
+    FixedClipboard clipboard{"def"}; // short enough to fit in std::string without allocation
+    CommandHistory history{without_coalescing(16)};
+    PasteCmd paste_cmd{doc, clipboard, history};
+    UndoCmd undo_cmd{console, history};
+
+    auto edit = [&] {
+        paste_cmd.execute();
+        paste_cmd.execute();
+        undo_cmd.execute();
+        undo_cmd.execute();
+    };
+
+    for (int i = 0; i < 8; ++i) // warm-up
+        edit();
+
+    const size_t new_calls_before = new_calls;
+    for (int i = 0; i < 1'000; ++i)
+        edit();
+    const size_t new_calls_after = new_calls;
+
+    ASSERT_THAT(new_calls_after - new_calls_before, Eq(0));
+    ASSERT_THAT(doc.text(), StrEq("abc"));
+}
+
+TEST_F(CommandPool_SteadyState, RecordingWithEvictionsDoesNotAllocate)
+{
+    FixedClipboard clipboard{""};
+    CommandHistory history{without_coalescing(4)};
+    PasteCmd paste_cmd{doc, clipboard, history};
+
+    for (int i = 0; i < 8; ++i) // warm-up
+        paste_cmd.execute();
+
+    const size_t new_calls_before = new_calls;
+    for (int i = 0; i < 1'000; ++i)
+        paste_cmd.execute();
+    const size_t new_calls_after = new_calls;
+
+    ASSERT_THAT(new_calls_after - new_calls_before, Eq(0));
+    ASSERT_THAT(history.stats().entries, Eq(4));
+    ASSERT_THAT(history.stats().evictions, Eq(1'004));
+}
+
+// mementos of Clear and ToUpper copy the text they replace and the document allocates
+// its pieces, so these commands allocate - but nothing more than the same edits made directly
+TEST_F(CommandPool_SteadyState, ClearAndToUpperAllocateOnlyForDocumentAndMementos)
+{
+    auto count_new_calls = [](auto edit) {
+        for (int i = 0; i < 8; ++i) // warm-up
+            edit();
+
+        const size_t new_calls_before = new_calls;
+        for (int i = 0; i < 1'000; ++i)
+            edit();
+
+        return new_calls - new_calls_before;
+    };
+
+    Document direct_doc{"abc"};
+    const size_t direct_new_calls = count_new_calls([&] {
+        auto upper_memento = direct_doc.create_memento(Document::CaseConversion::to_upper);
+        direct_doc.to_upper();
+        auto clear_memento = direct_doc.create_memento(0, direct_doc.length());
+        direct_doc.clear();
+        direct_doc.set_memento(clear_memento);
+        direct_doc.set_memento(upper_memento);
+    });
+
+    CommandHistory history{without_coalescing(16)};
+    ToUpperCmd to_upper_cmd{doc, history};
+    ClearCmd clear_cmd{doc, history};
+    UndoCmd undo_cmd{console, history};
+    const size_t cmd_new_calls = count_new_calls([&] {
+        to_upper_cmd.execute();
+        clear_cmd.execute();
+        undo_cmd.execute();
+        undo_cmd.execute();
+    });
+
+    ASSERT_THAT(cmd_new_calls, Eq(direct_new_calls));
+    ASSERT_THAT(doc.text(), StrEq("abc"));
+}
+
+TEST(CommandPool_Clone, ReusesMemoryOfDestroyedCommands)
+{
+    Document doc;
+    FixedClipboard clipboard{""};
+    CommandHistory history;
+    PasteCmd paste_cmd{doc, clipboard, history};
+
+    const UndoableCommand* first_address = paste_cmd.clone().get();
+    auto second = paste_cmd.clone();
+
+    ASSERT_THAT(second.get(), Eq(first_address));
+    ASSERT_EQ(typeid(*second), typeid(PasteCmd));
+}
+
+TEST(CommandPool_ThreadExit, CommandReleasedAfterFreeListIsDestroyedIsDeleted)
+{
+    std::thread t{[] {
+        // constructed before the free list, so destroyed after it at thread exit
+        thread_local std::optional<UndoableCommandPtr> late_cmd;
+        late_cmd.emplace();
+
+        Document doc;
+        FixedClipboard clipboard{""};
+        CommandHistory history;
+        PasteCmd paste_cmd{doc, clipboard, history};
+
+        *late_cmd = paste_cmd.clone();
+
+        watched_block = dynamic_cast<const void*>(late_cmd->get());
+        watched_block_delete_calls = 0;
+    }};
+
+    t.join(); // late_cmd is released after the free list of the thread is destroyed
+
+    const size_t late_cmd_delete_calls = watched_block_delete_calls;
+    watched_block = nullptr;
+
+    ASSERT_THAT(late_cmd_delete_calls, Eq(1));
+}
@@ -150,6 +150,38 @@ TEST_F(ToUpperCmd_Undo, RestoresDocumentState)
     ASSERT_THAT(doc.text(), StrEq("abc"));
 }
 
+TEST_F(ToUpperCmd_Undo, RestoresMixedCaseText)
+{
+    doc = Document{"aBc dEf"};
+    to_upper_cmd.execute();
+
+    auto last_cmd = cmd_history.pop_last_command();
+    last_cmd->undo();
+
+    ASSERT_THAT(doc.text(), StrEq("aBc dEf"));
+}
+
+//-----------------------------------------------------------------
+
+struct CommandHistory_RetainedBytes : UndoableCmdTests
+{
+};
+
+TEST_F(CommandHistory_RetainedBytes, AreReportedPerEntry)
+{
+    ClearCmd clear_cmd{doc, cmd_history};
+    ToUpperCmd to_upper_cmd{doc, cmd_history};
+
+    to_upper_cmd.execute();
+    clear_cmd.execute();
+
+    auto entries = cmd_history.retained_bytes_per_entry();
+
+    ASSERT_THAT(entries.size(), Eq(2));
+    ASSERT_THAT(entries[0], Ge(sizeof(ToUpperCmd) + 3));
+    ASSERT_THAT(entries[1], Ge(sizeof(ClearCmd) + 3));
+}
+
 //-----------------------------------------------------------------
 
 struct PasteCmd_Execute : UndoableCmdTests
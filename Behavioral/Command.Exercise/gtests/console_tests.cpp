@@ -0,0 +1,67 @@
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "console.hpp"
+
+using namespace ::testing;
+
+struct BatchConsole_Input : Test
+{
+    std::istringstream in;
+    std::ostringstream out;
+};
+
+TEST_F(BatchConsole_Input, SplitsLines)
+{
+    in.str("first\r\n\nlast");
+    BatchConsole console{in, out};
+
+    ASSERT_THAT(console.get_line(), StrEq("first"));
+    ASSERT_THAT(console.get_line(), StrEq(""));
+    ASSERT_FALSE(console.is_end_of_input());
+    ASSERT_THAT(console.get_line(), StrEq("last"));
+    ASSERT_FALSE(console.is_end_of_input());
+    ASSERT_THAT(console.get_line(), StrEq(""));
+    ASSERT_TRUE(console.is_end_of_input());
+}
+
+TEST_F(BatchConsole_Input, LinesCanSpanBlocks)
+{
+    const std::string long_line(200'000, 'x');
+    in.str("short\n" + long_line + "\nend\n");
+    BatchConsole console{in, out};
+
+    ASSERT_THAT(console.get_line(), StrEq("short"));
+    ASSERT_THAT(console.get_line(), StrEq(long_line));
+    ASSERT_THAT(console.get_line(), StrEq("end"));
+    console.get_line();
+    ASSERT_TRUE(console.is_end_of_input());
+}
+
+struct BatchConsole_Output : BatchConsole_Input
+{
+};
+
+TEST_F(BatchConsole_Output, IsBufferedUntilFlush)
+{
+    BatchConsole console{in, out};
+
+    console.print("abc");
+    ASSERT_THAT(out.str(), StrEq(""));
+
+    console.flush();
+    ASSERT_THAT(out.str(), StrEq("abc\n"));
+}
+
+TEST_F(BatchConsole_Output, IsFlushedWhenConsoleIsDestroyed)
+{
+    {
+        BatchConsole console{in, out};
+        console.print("abc");
+    }
+
+    ASSERT_THAT(out.str(), StrEq("abc\n"));
+}
@@ -93,6 +93,42 @@ TEST_F(Document_ReplacingText, TextIsReplaced)
     ASSERT_THAT(doc.text(), StrEq("xyzc"));
 }
 
+struct Document_EditingInTheMiddle : Document_ValueConstructed
+{
+};
+
+TEST_F(Document_EditingInTheMiddle, TextIsInserted)
+{
+    doc.insert(1, "xyz");
+
+    ASSERT_THAT(doc.text(), StrEq("axyzbc"));
+}
+
+TEST_F(Document_EditingInTheMiddle, TextIsErased)
+{
+    doc.insert(1, "xyz");
+    doc.erase(2, 3);
+
+    ASSERT_THAT(doc.text(), StrEq("axc"));
+}
+
+TEST_F(Document_EditingInTheMiddle, InsertingPastTheEndThrows)
+{
+    ASSERT_THROW(doc.insert(4, "x"), std::out_of_range);
+}
+
+TEST_F(Document_EditingInTheMiddle, ChunksMakeUpTheText)
+{
+    doc.insert(1, "xyz");
+    doc.add_text("def");
+
+    std::string text;
+    for (auto it = doc.chunks_begin(); it != doc.chunks_end(); ++it)
+        text += *it;
+
+    ASSERT_THAT(text, StrEq("axyzbcdef"));
+}
+
 struct Document_Memento : Document_ValueConstructed
 {
 };
@@ -104,4 +140,55 @@ TEST_F(Document_Memento, RestoresThePreviousState)
     doc.set_memento(snapshot);
 
     ASSERT_THAT(doc.text(), StrEq("abc"));
-}
\ No newline at end of file
+}
+
+TEST_F(Document_Memento, SnapshotIsTheDefault)
+{
+    auto snapshot = doc.create_memento();
+
+    ASSERT_TRUE(snapshot.is_snapshot());
+}
+
+struct Document_DeltaMemento : Test
+{
+    Document doc{"Hello, World! abc"};
+};
+
+TEST_F(Document_DeltaMemento, RestoresAChangedRange)
+{
+    auto delta = doc.create_memento(5, 8);
+    doc.replace(5, 8, " there");
+    doc.set_memento(delta);
+
+    ASSERT_FALSE(delta.is_snapshot());
+    ASSERT_THAT(doc.text(), StrEq("Hello, World! abc"));
+}
+
+TEST_F(Document_DeltaMemento, RestoresAClearedText)
+{
+    auto delta = doc.create_memento(0, doc.length());
+    doc.clear();
+    doc.set_memento(delta);
+
+    ASSERT_THAT(doc.text(), StrEq("Hello, World! abc"));
+}
+
+TEST_F(Document_DeltaMemento, RestoresACaseConversion)
+{
+    auto delta = doc.create_memento(Document::CaseConversion::to_upper);
+    doc.to_upper();
+    doc.set_memento(delta);
+
+    ASSERT_THAT(doc.text(), StrEq("Hello, World! abc"));
+}
+
+TEST_F(Document_DeltaMemento, CaseConversionKeepsOnlyChangedCharacters)
+{
+    Document upper_case_doc{std::string(1000, 'A') + "abc"};
+
+    auto delta = upper_case_doc.create_memento(Document::CaseConversion::to_upper);
+    auto snapshot = upper_case_doc.create_memento();
+
+    ASSERT_THAT(delta.retained_bytes(), Lt(100));
+    ASSERT_THAT(snapshot.retained_bytes(), Ge(1003));
+}
@@ -12,7 +12,7 @@ struct MockUndoableCommand : public UndoableCommand
 {
     MOCK_METHOD(void, execute, (), (override));
     MOCK_METHOD(void, undo, (), (override));
-    MOCK_METHOD(std::unique_ptr<UndoableCommand>, clone, (), (const, override));
+    MOCK_METHOD(UndoableCommandPtr, clone, (), (const, override));
 };
 
 #endif // MOCK_COMMAND_HPP
@@ -9,6 +9,8 @@ class MockConsole : public Console
 public:
     MOCK_METHOD(std::string, get_line, (), (override));
     MOCK_METHOD(void, print, (const std::string&), (override));
+    MOCK_METHOD(bool, is_end_of_input, (), (const, override));
+    MOCK_METHOD(void, flush, (), (override));
 };
 
 #endif // MOCK_CONSOLE_HPP
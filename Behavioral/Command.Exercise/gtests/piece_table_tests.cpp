@@ -0,0 +1,124 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "piece_table.hpp"
+
+using namespace ::testing;
+
+struct PieceTable_DefaultConstructed : Test
+{
+    PieceTable table;
+};
+
+TEST_F(PieceTable_DefaultConstructed, IsEmpty)
+{
+    ASSERT_TRUE(table.empty());
+    ASSERT_THAT(table.str(), StrEq(""));
+    ASSERT_THAT(table.piece_count(), Eq(0));
+    ASSERT_TRUE(table.chunks_begin() == table.chunks_end());
+}
+
+struct PieceTable_ValueConstructed : Test
+{
+    PieceTable table{"hello world"};
+};
+
+TEST_F(PieceTable_ValueConstructed, HoldsTheTextInOnePiece)
+{
+    ASSERT_THAT(table.str(), StrEq("hello world"));
+    ASSERT_THAT(table.size(), Eq(11));
+    ASSERT_THAT(table.piece_count(), Eq(1));
+}
+
+TEST_F(PieceTable_ValueConstructed, InsertSplitsAPiece)
+{
+    table.insert(5, ",");
+
+    ASSERT_THAT(table.str(), StrEq("hello, world"));
+    ASSERT_THAT(table.piece_count(), Eq(3));
+}
+
+TEST_F(PieceTable_ValueConstructed, EraseIsClampedToTheEnd)
+{
+    table.erase(5, 100);
+
+    ASSERT_THAT(table.str(), StrEq("hello"));
+}
+
+TEST_F(PieceTable_ValueConstructed, ReplaceSwapsARange)
+{
+    table.replace(0, 5, "goodbye");
+
+    ASSERT_THAT(table.str(), StrEq("goodbye world"));
+}
+
+TEST_F(PieceTable_ValueConstructed, SubstrSpansPieces)
+{
+    table.insert(5, ",");
+
+    ASSERT_THAT(table.substr(3, 5), StrEq("lo, w"));
+    ASSERT_THAT(table.substr(10, 100), StrEq("ld"));
+    ASSERT_THAT(table.substr(12, 1), StrEq(""));
+}
+
+TEST_F(PieceTable_ValueConstructed, PositionsPastTheEndThrow)
+{
+    ASSERT_THROW(table.insert(12, "x"), std::out_of_range);
+    ASSERT_THROW(table.erase(12, 1), std::out_of_range);
+    ASSERT_THROW(table.replace(12, 1, "x"), std::out_of_range);
+    ASSERT_THROW(table.substr(12, 1), std::out_of_range);
+    ASSERT_THAT(table.str(), StrEq("hello world"));
+}
+
+TEST_F(PieceTable_ValueConstructed, ErasedPiecesAreReused)
+{
+    table.insert(5, ",");
+    table.erase(0, table.size());
+    table.insert(0, "abc");
+
+    ASSERT_THAT(table.str(), StrEq("abc"));
+    ASSERT_THAT(table.piece_count(), Eq(1));
+}
+
+TEST(PieceTable_RandomEdits, MatchAStdString)
+{
+    std::mt19937 rnd{42};
+    std::string expected = "The quick brown fox jumps over the lazy dog";
+    PieceTable table{expected};
+
+    for (int i = 0; i < 2'000; ++i)
+    {
+        const size_t pos = std::uniform_int_distribution<size_t>{0, expected.size()}(rnd);
+        const size_t count = std::uniform_int_distribution<size_t>{0, 8}(rnd);
+        const std::string text(std::uniform_int_distribution<size_t>{0, 5}(rnd), static_cast<char>('a' + i % 26));
+
+        switch (i % 3)
+        {
+        case 0:
+            expected.insert(pos, text);
+            table.insert(pos, text);
+            break;
+        case 1:
+            expected.erase(pos, count);
+            table.erase(pos, count);
+            break;
+        default:
+            expected.replace(pos, count, text);
+            table.replace(pos, count, text);
+        }
+
+        ASSERT_THAT(table.size(), Eq(expected.size()));
+        ASSERT_THAT(table.substr(pos, count), StrEq(expected.substr(pos, count)));
+    }
+
+    std::string chunks;
+    for (auto it = table.chunks_begin(); it != table.chunks_end(); ++it)
+        chunks += *it;
+
+    ASSERT_THAT(table.str(), StrEq(expected));
+    ASSERT_THAT(chunks, StrEq(expected));
+}
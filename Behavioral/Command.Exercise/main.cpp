@@ -1,3 +1,4 @@
+#include <fstream>
 #include <iostream>
 
 #include "application.hpp"
@@ -7,22 +8,67 @@
 using namespace std;
 namespace di = boost::di;
 
-int main()
+// usage: Command.Exercise [script]
+//  - without a script commands are read interactively
+//  - a script is a file with a command per line (with the text for AddText on the following line),
+//    "-" reads the script from the standard input (e.g. a pipe)
+
+namespace
 {
-    const auto injector = di::make_injector(
-        di::bind<Console>().to<Terminal>(),
-        di::bind<Clipboard>().to<SharedClipboard>());
+    template <typename TInjector>
+    Application create_application(const TInjector& injector)
+    {
+        auto app = injector.template create<Application>();
+
+        app.add_command("Print"s, injector.template create<std::shared_ptr<PrintCmd>>());
+        app.add_command("ToUpper"s, injector.template create<std::shared_ptr<ToUpperCmd>>());
+        app.add_command("Clear"s, injector.template create<std::shared_ptr<ClearCmd>>());
+        app.add_command("AddText"s, injector.template create<std::shared_ptr<AddTextCmd>>());
+        app.add_command("Paste"s, injector.template create<std::shared_ptr<PasteCmd>>());
+        app.add_command("Undo"s, injector.template create<std::shared_ptr<UndoCmd>>());
+        app.add_command("History"s, injector.template create<std::shared_ptr<HistoryCmd>>());
+
+        // TODO - register two commands: CopyCmd & ToLowerCmd
+
+        return app;
+    }
+}
 
-    auto app = injector.create<Application>();
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        const auto injector = di::make_injector(
+            di::bind<Console>().to<Terminal>(),
+            di::bind<Clipboard>().to<SharedClipboard>(),
+            di::bind<HistoryLimits>().to(HistoryLimits{}));
+
+        auto app = create_application(injector);
+        app.run();
+
+        return 0;
+    }
 
-    app.add_command("Print"s, injector.create<std::shared_ptr<PrintCmd>>());
-    app.add_command("ToUpper"s, injector.create<std::shared_ptr<ToUpperCmd>>());
-    app.add_command("Clear"s, injector.create<std::shared_ptr<ClearCmd>>());
-    app.add_command("AddText"s, injector.create<std::shared_ptr<AddTextCmd>>());
-    app.add_command("Paste"s, injector.create<std::shared_ptr<PasteCmd>>());
-    app.add_command("Undo"s, injector.create<std::shared_ptr<UndoCmd>>());
+    ios::sync_with_stdio(false);
 
-    // TODO - register two commands: CopyCmd & ToLowerCmd
+    ifstream script_file;
+    if (argv[1] != "-"s)
+    {
+        script_file.open(argv[1], ios::binary);
+        if (!script_file)
+        {
+            cerr << "Cannot open a script: " << argv[1] << endl;
+            return 1;
+        }
+    }
+
+    BatchConsole console{script_file.is_open() ? script_file : cin, cout};
+
+    const auto injector = di::make_injector(
+        di::bind<Console>().to(console),
+        di::bind<Clipboard>().to<SharedClipboard>(),
+        di::bind<HistoryLimits>().to(HistoryLimits{}));
 
-    app.run();
+    auto app = create_application(injector);
+    app.run_batch();
 }
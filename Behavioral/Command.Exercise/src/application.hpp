@@ -2,6 +2,10 @@
 #define APPLICATION_HPP
 
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <deque>
+#include <string_view>
 #include <unordered_map>
 
 #include "command.hpp"
@@ -13,51 +17,151 @@ namespace Messages
     constexpr auto msg_prompt = "Enter a command: ";
 };
 
+// Commands by name - names are matched case-insensitively without copying the looked up text
+class CommandTable
+{
+    static const std::array<char, 256>& upper_case()
+    {
+        static const std::array<char, 256> table = [] {
+            std::array<char, 256> upper{};
+            for (size_t c = 0; c < upper.size(); ++c)
+                upper[c] = static_cast<char>(std::toupper(static_cast<int>(c)));
+
+            return upper;
+        }();
+
+        return table;
+    }
+
+    static char to_upper(char c)
+    {
+        return upper_case()[static_cast<unsigned char>(c)];
+    }
+
+    struct CaseInsensitiveHash
+    {
+        size_t operator()(std::string_view name) const
+        {
+            size_t hash = 14695981039346656037ull; // FNV-1a
+            for (char c : name)
+            {
+                hash ^= static_cast<unsigned char>(to_upper(c));
+                hash *= 1099511628211ull;
+            }
+
+            return hash;
+        }
+    };
+
+    struct CaseInsensitiveEqual
+    {
+        bool operator()(std::string_view left, std::string_view right) const
+        {
+            return CommandTable::equal(left, right);
+        }
+    };
+
+    std::deque<std::string> names_; // keys of cmds_ view these names (deque does not move its elements)
+    std::unordered_map<std::string_view, CommandSharedPtr, CaseInsensitiveHash, CaseInsensitiveEqual> cmds_;
+
+public:
+    CommandTable() = default;
+
+    // a copy would view the names of the source - moving a deque keeps its elements in place
+    CommandTable(const CommandTable&) = delete;
+    CommandTable& operator=(const CommandTable&) = delete;
+    CommandTable(CommandTable&&) = default;
+    CommandTable& operator=(CommandTable&&) = default;
+
+    static bool equal(std::string_view left, std::string_view right)
+    {
+        return left.size() == right.size()
+            && std::equal(left.begin(), left.end(), right.begin(), [](char a, char b) { return to_upper(a) == to_upper(b); });
+    }
+
+    // a command added with the same name as an existing one replaces it
+    void add(std::string name, CommandSharedPtr cmd)
+    {
+        if (auto pos = cmds_.find(name); pos != cmds_.end())
+        {
+            pos->second = std::move(cmd);
+            return;
+        }
+
+        names_.push_back(std::move(name));
+        cmds_.emplace(names_.back(), std::move(cmd));
+    }
+
+    // returns nullptr when the name is unknown
+    Command* find(std::string_view name) const
+    {
+        auto pos = cmds_.find(name);
+
+        return pos != cmds_.end() ? pos->second.get() : nullptr;
+    }
+};
+
 class Application
 {
     static const std::string cmd_exit;
 
     Console& console_;
-    std::unordered_map<std::string, CommandSharedPtr> cmds_;
+    CommandTable cmds_;
 
-public:
-    Application(Console& console)
-        : console_{console}
+    // returns false for the exit command
+    bool execute(const std::string& cmd)
     {
+        if (CommandTable::equal(cmd, Commands::cmd_exit))
+            return false;
+
+        if (Command* command = cmds_.find(cmd))
+        {
+            command->execute();
+        }
+        else
+        {
+            console_.print(Messages::msg_unknown_cmd + cmd);
+        }
+
+        return true;
     }
 
-    void run()
+    void run_loop(bool show_prompt)
     {
         while (true)
         {
-            console_.print(Messages::msg_prompt);
+            if (show_prompt)
+                console_.print(Messages::msg_prompt);
 
             auto cmd = console_.get_line();
-            to_upper(cmd);
 
-            if (cmd == Commands::cmd_exit)
+            if (console_.is_end_of_input() || !execute(cmd))
                 break;
-
-            if (auto pos = cmds_.find(cmd); pos != cmds_.end())
-            {
-                pos->second->execute();
-            }
-            else
-            {
-                console_.print(Messages::msg_unknown_cmd + cmd);
-            }
         }
+
+        console_.flush();
     }
 
-    void add_command(std::string name, CommandSharedPtr cmd)
+public:
+    Application(Console& console)
+        : console_{console}
     {
-        to_upper(name);
-        cmds_.emplace(std::move(name), cmd);
     }
-public:
-    void to_upper(std::string& text)
+
+    void run()
+    {
+        run_loop(true);
+    }
+
+    // runs a script - no prompts, stops at EXIT or at the end of the input
+    void run_batch()
+    {
+        run_loop(false);
+    }
+
+    void add_command(std::string name, CommandSharedPtr cmd)
     {
-        std::transform(text.begin(), text.end(), text.begin(), [](auto c) { return std::toupper(c);});
+        cmds_.add(std::move(name), std::move(cmd));
     }
 };
 
@@ -4,8 +4,13 @@
 #include "clipboard.hpp"
 #include "console.hpp"
 #include "document.hpp"
+#include <algorithm>
 #include <memory>
-#include <stack>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace Commands
 {
@@ -22,45 +27,306 @@ public:
 using CommandSharedPtr = std::shared_ptr<Command>;
 using CommandPtr = std::unique_ptr<Command>;
 
+class UndoableCommand;
+
+// Deletes commands created with new (no destroy function) or taken from a CommandPool
+struct CommandDeleter
+{
+    using DestroyFunction = void (*)(UndoableCommand*) noexcept;
+
+    DestroyFunction destroy = nullptr;
+
+    CommandDeleter() = default;
+
+    explicit CommandDeleter(DestroyFunction destroy) noexcept
+        : destroy{destroy}
+    {
+    }
+
+    template <typename T>
+    CommandDeleter(std::default_delete<T>) noexcept
+    {
+    }
+
+    void operator()(UndoableCommand* cmd) const noexcept;
+};
+
+using UndoableCommandPtr = std::unique_ptr<UndoableCommand, CommandDeleter>;
+
 class UndoableCommand : public Command
 {
 public:
     virtual void undo() = 0;
-    virtual std::unique_ptr<UndoableCommand> clone() const = 0;
+    virtual UndoableCommandPtr clone() const = 0;
+
+    // bytes kept by the command while it waits in the history for undo
+    virtual size_t retained_bytes() const
+    {
+        return 0;
+    }
+
+    // merges the next executed command into this one, so both are undone in a single step
+    // - returns false when the commands cannot be merged
+    virtual bool absorb(const UndoableCommand& /*next*/)
+    {
+        return false;
+    }
 };
 
-using UndoableCommandPtr = std::unique_ptr<UndoableCommand>;
+inline void CommandDeleter::operator()(UndoableCommand* cmd) const noexcept
+{
+    if (destroy)
+        destroy(cmd);
+    else
+        delete cmd;
+}
+
+// Memory for commands of type Cmd kept in the history - blocks of destroyed commands
+// are kept in a free list of the thread and reused, so once the pool has grown to the
+// peak number of live commands, creating a command does not call operator new
+template <typename Cmd>
+class CommandPool
+{
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static_assert(sizeof(Cmd) >= sizeof(FreeBlock) && alignof(Cmd) >= alignof(FreeBlock));
+
+    static constexpr std::align_val_t alignment{alignof(Cmd)};
+
+    struct FreeList
+    {
+        FreeBlock* head = nullptr;
+
+        ~FreeList()
+        {
+            while (head)
+                ::operator delete(std::exchange(head, head->next), alignment);
+
+            free_list_destroyed() = true;
+        }
+    };
+
+    static FreeList& free_list()
+    {
+        thread_local FreeList list;
+
+        return list;
+    }
+
+    // trivially destructible, so it can still be read when the free list of the thread
+    // is gone, e.g. by commands released from other thread_local or static objects
+    static bool& free_list_destroyed() noexcept
+    {
+        thread_local bool destroyed = false;
+
+        return destroyed;
+    }
+
+    static void* allocate()
+    {
+        if (free_list_destroyed())
+            return ::operator new(sizeof(Cmd), alignment);
+
+        FreeList& list = free_list();
+
+        if (!list.head)
+            return ::operator new(sizeof(Cmd), alignment);
+
+        return std::exchange(list.head, list.head->next);
+    }
+
+    static void deallocate(void* raw_mem) noexcept
+    {
+        if (free_list_destroyed())
+        {
+            ::operator delete(raw_mem, alignment);
+            return;
+        }
+
+        FreeList& list = free_list();
+        list.head = ::new (raw_mem) FreeBlock{list.head};
+    }
+
+    static void destroy(UndoableCommand* cmd) noexcept
+    {
+        Cmd* pooled_cmd = static_cast<Cmd*>(cmd);
+        pooled_cmd->~Cmd();
+        deallocate(pooled_cmd);
+    }
+
+public:
+    template <typename... TArgs>
+    static UndoableCommandPtr create(TArgs&&... args)
+    {
+        void* raw_mem = allocate();
+        try
+        {
+            return UndoableCommandPtr{::new (raw_mem) Cmd(std::forward<TArgs>(args)...), CommandDeleter{&destroy}};
+        }
+        catch (...)
+        {
+            deallocate(raw_mem);
+            throw;
+        }
+    }
+};
 
 template <typename Cmd, typename BaseCommand = UndoableCommand>
 class CloneableCommand : public BaseCommand
 {
 public:
-    std::unique_ptr<UndoableCommand> clone() const override
+    UndoableCommandPtr clone() const override
+    {
+        return CommandPool<Cmd>::create(static_cast<Cmd const&>(*this));
+    }
+
+    size_t retained_bytes() const override
     {
-        return std::make_unique<Cmd>(static_cast<Cmd const&>(*this));
+        return sizeof(Cmd);
     }
 };
 
+struct HistoryLimits
+{
+    size_t max_entries = 1'000;
+    size_t max_bytes = 64 * 1024 * 1024; // bytes retained by all entries
+    bool coalesce_edits = true;          // merge adjacent edits into a single undo step
+};
+
+// Commands waiting for undo in a ring buffer - when a limit is exceeded the oldest
+// entries are evicted (the last command is always kept)
 class CommandHistory
 {
-    std::stack<UndoableCommandPtr> history_;
+public:
+    struct Stats
+    {
+        size_t entries;
+        size_t retained_bytes;
+        size_t evictions;
+        size_t coalesced_commands;
+    };
+
+private:
+    struct Entry
+    {
+        UndoableCommandPtr cmd;
+        size_t retained_bytes;
+    };
+
+    HistoryLimits limits_;
+    std::vector<Entry> entries_; // grows up to max_entries, then is reused as a ring
+    size_t first_ = 0;           // index of the oldest entry
+    size_t count_ = 0;
+    size_t retained_bytes_ = 0;
+    size_t evictions_ = 0;
+    size_t coalesced_commands_ = 0;
+
+    size_t index_of(size_t position) const
+    {
+        return (first_ + position) % entries_.size();
+    }
+
+    Entry& last_entry()
+    {
+        return entries_[index_of(count_ - 1)];
+    }
+
+    void evict_oldest()
+    {
+        Entry& oldest = entries_[first_];
+        retained_bytes_ -= oldest.retained_bytes;
+        oldest.cmd.reset();
+
+        first_ = (first_ + 1) % entries_.size();
+        --count_;
+        ++evictions_;
+    }
+
+    void push_back(Entry entry)
+    {
+        if (count_ == entries_.size() && entries_.size() < limits_.max_entries)
+        {
+            // the free slots are after the last entry only when the ring is not wrapped
+            std::rotate(entries_.begin(), entries_.begin() + first_, entries_.end());
+            first_ = 0;
+            entries_.push_back(std::move(entry));
+        }
+        else
+        {
+            if (count_ == entries_.size())
+                evict_oldest();
+
+            entries_[index_of(count_)] = std::move(entry);
+        }
+
+        ++count_;
+    }
 
 public:
+    explicit CommandHistory(HistoryLimits limits = {})
+        : limits_{limits}
+    {
+        if (limits_.max_entries == 0)
+            throw std::invalid_argument("Command history must keep at least one entry");
+    }
+
     void record_last_command(UndoableCommandPtr cmd)
     {
-        history_.push(std::move(cmd));
+        if (limits_.coalesce_edits && count_ > 0 && last_entry().cmd->absorb(*cmd))
+        {
+            Entry& last = last_entry();
+            retained_bytes_ -= last.retained_bytes;
+            last.retained_bytes = last.cmd->retained_bytes();
+            retained_bytes_ += last.retained_bytes;
+            ++coalesced_commands_;
+        }
+        else
+        {
+            const size_t bytes = cmd->retained_bytes();
+            push_back(Entry{std::move(cmd), bytes});
+            retained_bytes_ += bytes;
+        }
+
+        while (retained_bytes_ > limits_.max_bytes && count_ > 1)
+            evict_oldest();
     }
 
     UndoableCommandPtr pop_last_command()
     {
-
-        if (history_.empty())
+        if (count_ == 0)
             throw std::out_of_range("Command history is empty");
-        auto last_cmd = std::move(history_.top());
-        history_.pop();
+        Entry& last = last_entry();
+        auto last_cmd = std::move(last.cmd);
+        retained_bytes_ -= last.retained_bytes;
+        --count_;
 
         return last_cmd;
     }
+
+    size_t size() const
+    {
+        return count_;
+    }
+
+    Stats stats() const
+    {
+        return Stats{count_, retained_bytes_, evictions_, coalesced_commands_};
+    }
+
+    // from the oldest to the last command
+    std::vector<size_t> retained_bytes_per_entry() const
+    {
+        std::vector<size_t> bytes;
+        bytes.reserve(count_);
+
+        for (size_t i = 0; i < count_; ++i)
+            bytes.push_back(entries_[index_of(i)].retained_bytes);
+
+        return bytes;
+    }
 };
 
 template <typename CommandType, typename CommandBaseType = UndoableCommand>
@@ -74,11 +340,14 @@ public:
     {
     }
 
+    // the command is recorded after execution, so the entry describes the completed edit -
+    // the state saved for undo is moved into the entry instead of being copied, as it is
+    // saved again by the next execution
     void execute() final override
     {
         do_save_state();
-        history_.record_last_command(this->clone());
         do_execute();
+        history_.record_last_command(CommandPool<CommandType>::create(std::move(static_cast<CommandType&>(*this))));
     }
 
     void undo() final override
@@ -127,7 +396,7 @@ public:
 protected:
     void do_save_state() override
     {
-        memento_ = doc_.create_memento();
+        memento_ = doc_.create_memento(0, doc_.length());
     }
 
     void do_execute() override
@@ -140,6 +409,12 @@ protected:
         doc_.set_memento(memento_);
     }
 
+public:
+    size_t retained_bytes() const override
+    {
+        return UndoableCommandBase::retained_bytes() + memento_.retained_bytes();
+    }
+
 private:
     Document& doc_;
     Document::Memento memento_;
@@ -159,7 +434,7 @@ public:
 protected:
     void do_save_state() override
     {
-        memento_ = doc_.create_memento();
+        memento_ = doc_.create_memento(Document::CaseConversion::to_upper);
     }
 
     void do_execute() override
@@ -172,14 +447,61 @@ protected:
         doc_.set_memento(memento_);
     }
 
+public:
+    size_t retained_bytes() const override
+    {
+        return UndoableCommandBase::retained_bytes() + memento_.retained_bytes();
+    }
+
 private:
     Document& doc_;
     Document::Memento memento_;
 };
 
+//--------------------------------------------------------------------------------
+// Base of commands appending text to the document - appends of adjacent text
+// recorded one after another are undone in a single step
+class AppendTextCommand : public UndoableCommand
+{
+public:
+    bool absorb(const UndoableCommand& next) override
+    {
+        auto next_append = dynamic_cast<const AppendTextCommand*>(&next);
+
+        if (!next_append || next_append->doc_ != doc_ || next_append->begin_ != end_)
+            return false;
+
+        end_ = next_append->end_;
+
+        return true;
+    }
+
+protected:
+    void begin_append(Document& doc)
+    {
+        doc_ = &doc;
+        begin_ = end_ = doc.length();
+    }
+
+    void end_append()
+    {
+        end_ = doc_->length();
+    }
+
+    void undo_append()
+    {
+        doc_->erase(begin_, end_ - begin_);
+    }
+
+private:
+    Document* doc_ = nullptr;
+    size_t begin_{}; // range of the appended text
+    size_t end_{};
+};
+
 //--------------------------------------------------------------------------------
 // Paste command
-class PasteCmd : public UndoableCommandBase<PasteCmd>
+class PasteCmd : public UndoableCommandBase<PasteCmd, AppendTextCommand>
 {
 public:
     PasteCmd(Document& doc, Clipboard& clipboard_, CommandHistory& history)
@@ -192,25 +514,23 @@ public:
 protected:
     void do_save_state() override
     {
-        prev_length_ = doc_.length();
+        begin_append(doc_);
     }
 
     void do_execute() override
     {
         doc_.add_text(clipboard_.content());
+        end_append();
     }
 
     void do_undo() override
     {
-        size_t count = doc_.length() - prev_length_;
-        doc_.replace(prev_length_, count, "");
+        undo_append();
     }
 
 private:
     Document& doc_;
     Clipboard& clipboard_;
-
-    size_t prev_length_{};
 };
 
 //--------------------------------------------------------------------------------
@@ -242,9 +562,37 @@ private:
     CommandHistory& history_;
 };
 
+//--------------------------------------------------------------------------------
+// History command - reports memory kept for undo
+class HistoryCmd : public Command
+{
+public:
+    HistoryCmd(Console& console, CommandHistory& history)
+        : console_{console}
+        , history_(history)
+    {
+    }
+
+    void execute() override
+    {
+        const auto entries = history_.retained_bytes_per_entry();
+
+        for (size_t i = 0; i < entries.size(); ++i)
+            console_.print("#" + std::to_string(i + 1) + ": " + std::to_string(entries[i]) + " bytes");
+
+        const auto stats = history_.stats();
+        console_.print("History entries: " + std::to_string(stats.entries) + ", retained bytes: " + std::to_string(stats.retained_bytes)
+            + ", evictions: " + std::to_string(stats.evictions) + ", coalesced commands: " + std::to_string(stats.coalesced_commands));
+    }
+
+private:
+    Console& console_;
+    CommandHistory& history_;
+};
+
 //--------------------------------------------------------------------------------
 // AddText command
-class AddTextCmd : public UndoableCommandBase<AddTextCmd>
+class AddTextCmd : public UndoableCommandBase<AddTextCmd, AppendTextCommand>
 {
 public:
     AddTextCmd(Document& doc, Console& console, CommandHistory& history)
@@ -257,7 +605,7 @@ public:
 protected:
     void do_save_state() override
     {
-        prev_length_ = doc_.length();
+        begin_append(doc_);
     }
 
     void do_execute() override
@@ -265,18 +613,17 @@ protected:
         console_.print("Write text: ");
         auto txt = console_.get_line();
         doc_.add_text(txt);
+        end_append();
     }
 
     void do_undo() override
     {
-        auto count = doc_.length() - prev_length_;
-        doc_.replace(prev_length_, count, "");
+        undo_append();
     }
 
 private:
     Document& doc_;
     Console& console_;
-    size_t prev_length_{};
 };
 
 //--------------------------------------------------------------------------------
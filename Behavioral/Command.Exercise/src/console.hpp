@@ -1,8 +1,10 @@
 #ifndef CONSOLE_HPP
 #define CONSOLE_HPP
 
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 
 class Console
 {
@@ -10,22 +12,137 @@ public:
     virtual std::string get_line() = 0;
     virtual void print(const std::string& line) = 0;
     virtual ~Console() = default;
+
+    // true when the last get_line() found no more input
+    virtual bool is_end_of_input() const
+    {
+        return false;
+    }
+
+    virtual void flush()
+    {
+    }
 };
 
 class Terminal : public Console
 {
+    bool is_end_of_input_ = false;
+
+public:
+    std::string get_line() override
+    {
+        std::string line;
+        is_end_of_input_ = !std::getline(std::cin, line);
+
+        return line;
+    }
+
+    // std::cin is tied to std::cout - the output is flushed before the next line is read
+    void print(const std::string& line) override
+    {
+        std::cout << line << '\n';
+    }
+
+    bool is_end_of_input() const override
+    {
+        return is_end_of_input_;
+    }
+
+    void flush() override
+    {
+        std::cout.flush();
+    }
+};
+
+// Console for scripts (files or pipes) - the input is read in large blocks
+// and the output is buffered until a block is full or the console is flushed
+class BatchConsole : public Console
+{
+    static constexpr size_t block_size = 64 * 1024;
+
+    std::istream& in_;
+    std::ostream& out_;
+    std::vector<char> in_block_;
+    size_t in_pos_ = 0;
+    size_t in_end_ = 0;
+    bool is_end_of_input_ = false;
+    std::string out_block_;
+
+    bool read_block()
+    {
+        in_.read(in_block_.data(), in_block_.size());
+        in_pos_ = 0;
+        in_end_ = static_cast<size_t>(in_.gcount());
+
+        return in_end_ > 0;
+    }
+
 public:
+    BatchConsole(std::istream& in, std::ostream& out)
+        : in_{in}
+        , out_{out}
+        , in_block_(block_size)
+    {
+        out_block_.reserve(block_size);
+    }
+
+    BatchConsole(const BatchConsole&) = delete;
+    BatchConsole& operator=(const BatchConsole&) = delete;
+
+    ~BatchConsole()
+    {
+        flush();
+    }
+
     std::string get_line() override
     {
         std::string line;
-        std::getline(std::cin, line);
+        bool is_found = false; // any characters of a line (including its end) were read
+
+        while (in_pos_ < in_end_ || read_block())
+        {
+            const char* begin = in_block_.data() + in_pos_;
+            const size_t available = in_end_ - in_pos_;
+            is_found = true;
+
+            if (auto line_end = static_cast<const char*>(std::memchr(begin, '\n', available)))
+            {
+                line.append(begin, line_end);
+                in_pos_ += (line_end - begin) + 1;
+                break;
+            }
+
+            line.append(begin, available);
+            in_pos_ = in_end_;
+        }
+
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        is_end_of_input_ = !is_found;
 
         return line;
     }
 
     void print(const std::string& line) override
     {
-        std::cout << line << std::endl;
+        out_block_ += line;
+        out_block_ += '\n';
+
+        if (out_block_.size() >= block_size)
+            flush();
+    }
+
+    bool is_end_of_input() const override
+    {
+        return is_end_of_input_;
+    }
+
+    void flush() override
+    {
+        out_.write(out_block_.data(), out_block_.size());
+        out_.flush();
+        out_block_.clear();
     }
 };
 
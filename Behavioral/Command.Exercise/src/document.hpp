@@ -1,25 +1,63 @@
 #ifndef DOCUMENT_HPP
 #define DOCUMENT_HPP
 
+#include "piece_table.hpp"
 #include "serializers.hpp"
-#include <array>
 
 #include <algorithm>
 #include <cctype>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 class Document
 {
-    std::string text_;
+    PieceTable text_; // edits are O(log n) in the number of pieces - see piece_table.hpp
 
 public:
+    enum class CaseConversion
+    {
+        to_upper,
+        to_lower
+    };
+
+    // State of the document saved for undo - either a full snapshot of the text or
+    // a delta: ranges of old characters to put back in place of their current content
     class Memento
     {
     private:
+        struct Change
+        {
+            size_t position;
+            std::string old_text;
+        };
+
+        // unchanged characters between two changes up to this count are stored in a single change
+        static constexpr size_t max_unchanged_gap = sizeof(Change);
+
+        bool is_snapshot_ = false;
         std::string snapshot_;
+        std::vector<Change> changes_;
+        size_t length_{}; // length of the document when the memento was created
 
         friend class Document;
+
+    public:
+        bool is_snapshot() const
+        {
+            return is_snapshot_;
+        }
+
+        // characters and bookkeeping kept by the memento
+        size_t retained_bytes() const
+        {
+            size_t bytes = snapshot_.size() + changes_.capacity() * sizeof(Change);
+            for (const auto& change : changes_)
+                bytes += change.old_text.size();
+
+            return bytes;
+        }
     };
 
     Document()
@@ -32,9 +70,21 @@ public:
     {
     }
 
+    // materializes the whole text - prefer chunks for large documents
     std::string text() const
     {
-        return text_;
+        return text_.str();
+    }
+
+    // the text as views of consecutive pieces (invalidated by the next modification)
+    PieceTable::ChunkIterator chunks_begin() const
+    {
+        return text_.chunks_begin();
+    }
+
+    PieceTable::ChunkIterator chunks_end() const
+    {
+        return text_.chunks_end();
     }
 
     size_t length() const
@@ -44,17 +94,27 @@ public:
 
     void add_text(const std::string& txt)
     {
-        text_ += txt;
+        text_.insert(text_.size(), txt);
+    }
+
+    void insert(size_t pos, std::string_view text)
+    {
+        text_.insert(pos, text);
+    }
+
+    void erase(size_t pos, size_t count)
+    {
+        text_.erase(pos, count);
     }
 
     void to_upper()
     {
-        std::transform(text_.begin(), text_.end(), text_.begin(), [](auto c) { return std::toupper(c); });
+        transform_text(&Document::upper);
     }
 
     void to_lower()
     {
-        std::transform(text_.begin(), text_.end(), text_.begin(), [](auto c) { return std::tolower(c); });
+        transform_text(&Document::lower);
     }
 
     void clear()
@@ -62,35 +122,150 @@ public:
         text_.clear();
     }
 
+    // full snapshot of the text - O(n)
     template <template <typename> class Serializer = StreamOutputSerializer>
     Memento create_memento() const
     {
+        const std::string text = text_.str();
+
         std::stringstream stream;
         {
             Serializer archive(stream);
-            archive(text_);
+            archive(text);
         }
 
         Memento memento;
+        memento.is_snapshot_ = true;
         memento.snapshot_ = stream.str();
+        memento.length_ = text.size();
+
+        return memento;
+    }
+
+    // delta for an edit that replaces the range [start_pos, start_pos + count) and leaves
+    // the rest of the text intact - keeps only the old characters of the range
+    Memento create_memento(size_t start_pos, size_t count) const
+    {
+        if (start_pos > length())
+            throw std::out_of_range("Document: memento range out of the text");
+
+        count = std::min(count, length() - start_pos);
+
+        Memento memento;
+        memento.length_ = length();
+        if (count > 0)
+            memento.changes_.push_back({start_pos, text_.substr(start_pos, count)});
 
         return memento;
     }
 
+    // delta for to_upper() or to_lower() - keeps only the characters the conversion changes
+    Memento create_memento(CaseConversion conversion) const
+    {
+        return conversion == CaseConversion::to_upper
+            ? create_transform_memento(&Document::upper)
+            : create_transform_memento(&Document::lower);
+    }
+
+    // O(n) for a snapshot, O(changed characters) for a delta created in the current state of the document
     template <template <typename> class Serializer = StreamInputSerializer>
     void set_memento(Memento& memento)
     {
+        if (!memento.is_snapshot_)
+        {
+            restore_changes(memento);
+            return;
+        }
+
+        std::string text;
+
         std::stringstream stream{memento.snapshot_};
         Serializer archive(stream);
-        archive(text_);
+        archive(text);
+
+        text_ = PieceTable{std::move(text)};
     }
 
     void replace(size_t start_pos, size_t count, const std::string& text)
     {
         text_.replace(start_pos, count, text);
     }
-};
 
-#endif
+private:
+    static char upper(char c)
+    {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+
+    static char lower(char c)
+    {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    template <typename Transformation>
+    Memento create_transform_memento(Transformation transformation) const
+    {
+        Memento memento;
+        memento.length_ = length();
+
+        size_t position = 0;
+        size_t unchanged_tail = 0; // unchanged characters at the end of the last change
+
+        auto close_change = [&] {
+            memento.changes_.back().old_text.resize(memento.changes_.back().old_text.size() - unchanged_tail);
+            unchanged_tail = 0;
+        };
+
+        for (auto it = chunks_begin(); it != chunks_end(); ++it)
+        {
+            for (char c : *it)
+            {
+                const bool is_changed = transformation(c) != c;
+                const bool is_in_change = !memento.changes_.empty() && memento.changes_.back().position + memento.changes_.back().old_text.size() == position;
 
+                if (is_in_change)
+                {
+                    memento.changes_.back().old_text += c;
+                    unchanged_tail = is_changed ? 0 : unchanged_tail + 1;
 
+                    if (unchanged_tail > Memento::max_unchanged_gap)
+                        close_change();
+                }
+                else if (is_changed)
+                {
+                    memento.changes_.push_back({position, std::string(1, c)});
+                }
+
+                ++position;
+            }
+        }
+
+        if (!memento.changes_.empty())
+            close_change();
+
+        memento.changes_.shrink_to_fit();
+
+        return memento;
+    }
+
+    void restore_changes(const Memento& memento)
+    {
+        // only a single-range delta may change the length of the text
+        const size_t growth = length() - memento.length_; // modulo arithmetic - may wrap
+
+        for (auto it = memento.changes_.rbegin(); it != memento.changes_.rend(); ++it)
+            text_.replace(it->position, it->old_text.size() + growth, it->old_text);
+    }
+
+    // rewrites every character - the result is stored as a single piece
+    template <typename Transformation>
+    void transform_text(Transformation transformation)
+    {
+        std::string text = text_.str();
+        std::transform(text.begin(), text.end(), text.begin(), transformation);
+
+        text_ = PieceTable{std::move(text)};
+    }
+};
+
+#endif
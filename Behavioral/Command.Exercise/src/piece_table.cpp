@@ -0,0 +1,266 @@
+#include "piece_table.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+PieceTable::PieceTable(string text)
+    : original_{std::move(text)}
+{
+    if (!original_.empty())
+        root_ = make_node(Piece{false, 0, original_.size()});
+}
+
+// splits & merges cannot fail once the nodes they create are reserved
+void PieceTable::reserve_nodes(size_t count)
+{
+    if (free_nodes_.size() >= count || nodes_.capacity() - nodes_.size() >= count)
+        return;
+
+    if (nil - nodes_.size() < count)
+        throw length_error("PieceTable: too many pieces");
+
+    nodes_.reserve(max(2 * nodes_.size(), nodes_.size() + count));
+}
+
+PieceTable::NodeIndex PieceTable::make_node(const Piece& piece)
+{
+    // xorshift32 - priorities only need to be independent of the positions
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+
+    const Node node{piece, piece.length, nil, nil, seed_};
+
+    if (!free_nodes_.empty())
+    {
+        const NodeIndex index = free_nodes_.back();
+        free_nodes_.pop_back();
+        nodes_[index] = node;
+
+        return index;
+    }
+
+    nodes_.push_back(node);
+
+    return static_cast<NodeIndex>(nodes_.size() - 1);
+}
+
+// free_nodes_ doubles as the queue of the traversal, so erasing does not allocate
+// once free_nodes_ has grown to the number of pieces
+void PieceTable::free_subtree(NodeIndex node)
+{
+    if (node == nil)
+        return;
+
+    size_t next = free_nodes_.size();
+    free_nodes_.push_back(node);
+
+    for (; next < free_nodes_.size(); ++next)
+    {
+        const Node& current = nodes_[free_nodes_[next]];
+
+        if (current.left != nil)
+            free_nodes_.push_back(current.left);
+        if (current.right != nil)
+            free_nodes_.push_back(current.right);
+
+        // text inserted last and erased (e.g. an undone insert) gives its space back
+        if (current.piece.is_added && current.piece.offset + current.piece.length == added_.size())
+            added_.resize(current.piece.offset);
+    }
+}
+
+void PieceTable::update(NodeIndex node)
+{
+    Node& n = nodes_[node];
+    n.subtree_length = subtree_length(n.left) + n.piece.length + subtree_length(n.right);
+}
+
+// (first pos characters, the rest) - a piece containing pos is cut in two
+pair<PieceTable::NodeIndex, PieceTable::NodeIndex> PieceTable::split(NodeIndex node, size_t pos)
+{
+    if (node == nil)
+        return {nil, nil};
+
+    const size_t left_length = subtree_length(nodes_[node].left);
+    const size_t piece_length = nodes_[node].piece.length;
+
+    if (pos <= left_length)
+    {
+        auto [first, rest] = split(nodes_[node].left, pos);
+        nodes_[node].left = rest;
+        update(node);
+
+        return {first, node};
+    }
+
+    if (pos >= left_length + piece_length)
+    {
+        auto [first, rest] = split(nodes_[node].right, pos - left_length - piece_length);
+        nodes_[node].right = first;
+        update(node);
+
+        return {node, rest};
+    }
+
+    const size_t cut = pos - left_length;
+    const Piece& piece = nodes_[node].piece;
+    const NodeIndex tail = make_node(Piece{piece.is_added, piece.offset + cut, piece.length - cut}); // may reallocate nodes_
+
+    const NodeIndex right = nodes_[node].right;
+    nodes_[node].piece.length = cut;
+    nodes_[node].right = nil;
+    update(node);
+
+    return {node, merge(tail, right)};
+}
+
+PieceTable::NodeIndex PieceTable::merge(NodeIndex left, NodeIndex right)
+{
+    if (left == nil)
+        return right;
+    if (right == nil)
+        return left;
+
+    if (nodes_[left].priority > nodes_[right].priority)
+    {
+        const NodeIndex merged = merge(nodes_[left].right, right);
+        nodes_[left].right = merged;
+        update(left);
+
+        return left;
+    }
+
+    const NodeIndex merged = merge(left, nodes_[right].left);
+    nodes_[right].left = merged;
+    update(right);
+
+    return right;
+}
+
+void PieceTable::insert(size_t pos, string_view text)
+{
+    if (pos > size())
+        throw out_of_range("PieceTable: insert position out of range");
+
+    if (text.empty())
+        return;
+
+    reserve_nodes(2); // the inserted piece & the tail of a piece cut at pos
+    added_.append(text);
+
+    const NodeIndex node = make_node(Piece{true, added_.size() - text.size(), text.size()});
+
+    auto [first, rest] = split(root_, pos);
+    root_ = merge(merge(first, node), rest);
+}
+
+void PieceTable::erase(size_t pos, size_t count)
+{
+    if (pos > size())
+        throw out_of_range("PieceTable: erase position out of range");
+
+    count = min(count, size() - pos);
+
+    if (count == 0)
+        return;
+
+    reserve_nodes(2); // tails of pieces cut at both ends of the range
+    auto [first, rest] = split(root_, pos);
+    auto [erased, last] = split(rest, count);
+
+    root_ = merge(first, last);
+    free_subtree(erased);
+}
+
+void PieceTable::replace(size_t pos, size_t count, string_view text)
+{
+    if (pos > size())
+        throw out_of_range("PieceTable: replace position out of range");
+
+    erase(pos, count);
+    insert(pos, text);
+}
+
+void PieceTable::clear()
+{
+    original_.clear();
+    added_.clear();
+    nodes_.clear();
+    free_nodes_.clear();
+    root_ = nil;
+}
+
+string PieceTable::str() const
+{
+    string result;
+    result.reserve(size());
+
+    for (auto chunk = chunks_begin(); chunk != chunks_end(); ++chunk)
+        result.append(*chunk);
+
+    return result;
+}
+
+// appends count characters from pos of the subtree (the range lies within the subtree)
+void PieceTable::append_range(NodeIndex node, size_t pos, size_t count, string& out) const
+{
+    if (node == nil || count == 0)
+        return;
+
+    const size_t piece_begin = subtree_length(nodes_[node].left);
+    const size_t piece_end = piece_begin + nodes_[node].piece.length;
+    const size_t end = pos + count;
+
+    if (pos < piece_begin)
+        append_range(nodes_[node].left, pos, min(end, piece_begin) - pos, out);
+
+    if (pos < piece_end && end > piece_begin)
+    {
+        const size_t first = max(pos, piece_begin);
+        out.append(text_of(nodes_[node].piece).substr(first - piece_begin, min(end, piece_end) - first));
+    }
+
+    if (end > piece_end)
+    {
+        const size_t first = max(pos, piece_end);
+        append_range(nodes_[node].right, first - piece_end, end - first, out);
+    }
+}
+
+string PieceTable::substr(size_t pos, size_t count) const
+{
+    if (pos > size())
+        throw out_of_range("PieceTable: substr position out of range");
+
+    count = min(count, size() - pos);
+
+    string result;
+    result.reserve(count);
+    append_range(root_, pos, count, result);
+
+    return result;
+}
+
+PieceTable::ChunkIterator::ChunkIterator(const PieceTable& table)
+    : table_{&table}
+{
+    push_leftmost(table.root_);
+}
+
+void PieceTable::ChunkIterator::push_leftmost(NodeIndex node)
+{
+    for (; node != nil; node = table_->nodes_[node].left)
+        path_.push_back(node);
+}
+
+PieceTable::ChunkIterator& PieceTable::ChunkIterator::operator++()
+{
+    const NodeIndex current = path_.back();
+    path_.pop_back();
+    push_leftmost(table_->nodes_[current].right);
+
+    return *this;
+}
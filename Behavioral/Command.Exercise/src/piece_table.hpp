@@ -0,0 +1,150 @@
+#ifndef PIECE_TABLE_HPP
+#define PIECE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Text stored as a sequence of pieces - ranges of an immutable original buffer or of an
+// append-only buffer with inserted text. Pieces are nodes of a treap ordered by position
+// and augmented with subtree lengths, so insert, erase and replace take O(log n) in the
+// number of pieces and never move the text itself.
+class PieceTable
+{
+    using NodeIndex = std::uint32_t;
+    static constexpr NodeIndex nil = UINT32_MAX;
+
+    struct Piece
+    {
+        bool is_added; // in added_, otherwise in original_
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    struct Node
+    {
+        Piece piece;
+        std::size_t subtree_length;
+        NodeIndex left = nil;
+        NodeIndex right = nil;
+        std::uint32_t priority;
+    };
+
+    std::string original_;
+    std::string added_;
+    std::vector<Node> nodes_;
+    std::vector<NodeIndex> free_nodes_;
+    NodeIndex root_ = nil;
+    std::uint32_t seed_ = 2463534242u;
+
+    std::size_t subtree_length(NodeIndex node) const
+    {
+        return node == nil ? 0 : nodes_[node].subtree_length;
+    }
+
+    std::string_view text_of(const Piece& piece) const
+    {
+        return std::string_view{piece.is_added ? added_ : original_}.substr(piece.offset, piece.length);
+    }
+
+    void reserve_nodes(std::size_t count);
+    NodeIndex make_node(const Piece& piece);
+    void free_subtree(NodeIndex node);
+    void update(NodeIndex node);
+    std::pair<NodeIndex, NodeIndex> split(NodeIndex node, std::size_t pos);
+    NodeIndex merge(NodeIndex left, NodeIndex right);
+    void append_range(NodeIndex node, std::size_t pos, std::size_t count, std::string& out) const;
+
+public:
+    PieceTable() = default;
+    explicit PieceTable(std::string text);
+
+    std::size_t size() const
+    {
+        return subtree_length(root_);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    std::size_t piece_count() const
+    {
+        return nodes_.size() - free_nodes_.size();
+    }
+
+    // throw std::out_of_range when pos > size() - count is clamped to the end of the text
+    void insert(std::size_t pos, std::string_view text);
+    void erase(std::size_t pos, std::size_t count);
+    void replace(std::size_t pos, std::size_t count, std::string_view text);
+
+    void clear();
+
+    // O(n) - copies the whole text
+    std::string str() const;
+
+    // O(log n + count) - throws std::out_of_range when pos > size(), count is clamped to the end of the text
+    std::string substr(std::size_t pos, std::size_t count) const;
+
+    // iterates over the text as views of consecutive pieces in document order
+    // (views are invalidated by the next modification)
+    class ChunkIterator
+    {
+        const PieceTable* table_ = nullptr;
+        std::vector<NodeIndex> path_; // the current node is on the top
+
+        void push_leftmost(NodeIndex node);
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        ChunkIterator() = default;
+        explicit ChunkIterator(const PieceTable& table);
+
+        std::string_view operator*() const
+        {
+            return table_->text_of(table_->nodes_[path_.back()].piece);
+        }
+
+        ChunkIterator& operator++();
+
+        ChunkIterator operator++(int)
+        {
+            ChunkIterator previous = *this;
+            ++*this;
+
+            return previous;
+        }
+
+        bool operator==(const ChunkIterator& other) const
+        {
+            return path_.empty() ? other.path_.empty() : (!other.path_.empty() && path_.back() == other.path_.back());
+        }
+
+        bool operator!=(const ChunkIterator& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    ChunkIterator chunks_begin() const
+    {
+        return ChunkIterator{*this};
+    }
+
+    ChunkIterator chunks_end() const
+    {
+        return ChunkIterator{};
+    }
+};
+
+#endif // PIECE_TABLE_HPP
@@ -8,7 +8,7 @@
 #include <vector>
 
 #include "shape.hpp"
-#include "shape_factories.hpp"
+#include "shape_type_registry.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -17,13 +17,11 @@ using namespace Drawing::IO;
 class GraphicsDoc
 {
     vector<unique_ptr<Shape>> shapes_;
-    ShapeFactory& shape_factory_;
-    ShapeRWFactory& shape_rw_factory_;
+    const ShapeTypeRegistry& shape_types_;
 
 public:
-    GraphicsDoc(ShapeFactory& shape_factory, ShapeRWFactory& shape_rw_factory)
-        : shape_factory_{shape_factory}
-        , shape_rw_factory_{shape_rw_factory}
+    GraphicsDoc(const ShapeTypeRegistry& shape_types)
+        : shape_types_{shape_types}
     {
     }
 
@@ -58,10 +56,10 @@ public:
 
             cout << "Loading " << shape_id << "..." << endl;
 
-            auto shape = shape_factory_.create(shape_id);
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shape));
+            const auto& shape_type = shape_types_.find(shape_id);
 
-            shape_rw->read(*shape, file_in);
+            auto shape = shape_type.create();
+            shape_type.shape_rw->read(*shape, file_in);
 
             shapes_.push_back(std::move(shape));
         }
@@ -72,10 +70,7 @@ public:
         ofstream file_out{filename};
 
         for (const auto& shp : shapes_)
-        {
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shp));
-            shape_rw->write(*shp, file_out);
-        }
+            shape_types_.find(*shp).shape_rw->write(*shp, file_out);
     }
 };
 
@@ -83,7 +78,7 @@ int main()
 {
     cout << "Start..." << endl;
 
-    GraphicsDoc doc(SingletonShapeFactory::instance(), SingletonShapeRWFactory::instance());
+    GraphicsDoc doc(SingletonShapeTypeRegistry::instance());
 
     doc.load("drawing_fm_exercise1.txt");
 
@@ -1,5 +1,6 @@
 #include "circle_reader_writer.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
 #include "../circle.hpp"
 
 using namespace std;
@@ -11,6 +12,8 @@ namespace
     bool is_registered =
             SingletonShapeRWFactory::instance()
                 .register_creator(make_type_index<Circle>(), []{ return make_unique<CircleReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Circle, CircleReaderWriter>();
 }
 
 
@@ -0,0 +1,127 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "poly_collection.hpp"
+#include "shape.hpp"
+#include "shapes.hpp"
+
+// usage: PolymorphicWrappers_poly_collection_benchmark [shape_count] [pass_count]
+
+namespace
+{
+    template <typename F>
+    double measure(F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // sum of all coordinates - the same for every container holding the same shapes
+    struct Checksum
+    {
+        long long value = 0;
+        bool is_complete = true;
+
+        void operator()(const Circle& c)
+        {
+            value += c.x + c.y;
+        }
+
+        void operator()(const Square& s)
+        {
+            value += s.x + s.y;
+        }
+
+        void operator()(const Triangle& t)
+        {
+            for (const auto& v : t.vertices)
+                value += v.x + v.y;
+        }
+
+        // coordinates of other shapes are not accessible
+        void operator()(const ShapeRef&)
+        {
+            is_complete = false;
+        }
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t shape_count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    const int pass_count = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    std::vector<Shape> shapes;
+    shapes.reserve(shape_count);
+    PolyCollection collection;
+
+    // types in random order - an unpredictable indirect call per shape in std::vector<Shape>
+    std::mt19937 rnd{42};
+    std::uniform_int_distribution<int> type{0, 2};
+    long long expected = 0;
+
+    for (std::size_t i = 0; i < shape_count; ++i)
+    {
+        const int n = static_cast<int>(i % 1000);
+
+        switch (type(rnd))
+        {
+        case 0:
+            shapes.push_back(collection.insert(Circle{n, n, 10}));
+            expected += 2 * n;
+            break;
+        case 1:
+            shapes.push_back(collection.insert(Square{n, n, 20}));
+            expected += 2 * n;
+            break;
+        default:
+            shapes.push_back(collection.insert(Triangle{{Point{n, 0}, Point{0, n}, Point{n, n}}}));
+            expected += 4 * n;
+        }
+    }
+
+    std::cout << "shapes: " << shape_count << "\tpasses: " << pass_count << std::endl;
+
+    auto vector_time = measure([&] {
+        for (int i = 0; i < pass_count; ++i)
+            for (auto& shp : shapes)
+                shp.move(1, -1);
+    });
+
+    auto segment_time = measure([&] {
+        for (int i = 0; i < pass_count; ++i)
+            collection.move(1, -1);
+    });
+
+    auto restored_time = measure([&] {
+        for (int i = 0; i < pass_count; ++i)
+            collection.for_each<Circle, Square, Triangle>([](auto& shp) { shp.move(1, -1); });
+    });
+
+    auto erased_time = measure([&] {
+        for (int i = 0; i < pass_count; ++i)
+            collection.for_each([](auto& shp) { shp.move(1, -1); });
+    });
+
+    auto report = [&](const std::string& name, double time) {
+        std::cout << name << ":\t" << time / pass_count * 1e3 << " ms/pass\tspeedup: " << vector_time / time << std::endl;
+    };
+
+    report("std::vector<Shape>", vector_time);
+    report("PolyCollection::move", segment_time);
+    report("for_each<Circle, Square, Triangle>", restored_time);
+    report("for_each (ShapeRef)", erased_time);
+
+    // every shape moved by (3 * pass_count, -3 * pass_count) - coordinates sum to the initial value
+    Checksum checksum;
+    collection.for_each<Circle, Square, Triangle>([&checksum](const auto& shp) { checksum(shp); });
+
+    const bool is_consistent = checksum.is_complete && checksum.value == expected && collection.size() == shapes.size();
+    std::cout << "results consistent: " << std::boolalpha << is_consistent << std::endl;
+
+    return is_consistent ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "shape.hpp"
+#include "shapes.hpp"
+
+#ifdef HAS_FOLLY_POLY
+#include <folly/Poly.h>
+#endif
+
+// usage: PolymorphicWrappers_wrapper_benchmark [shape_count]
+
+namespace
+{
+    std::atomic<std::size_t> allocation_count{0};
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    // the wrapper before small-buffer optimization - every shape in a heap-allocated ShapeWrapper<T>
+    class HeapShape
+    {
+        class IShape
+        {
+        public:
+            virtual ~IShape() = default;
+            virtual void move(int x, int y) = 0;
+            virtual void draw() const = 0;
+            virtual std::unique_ptr<IShape> clone() = 0;
+        };
+
+        template <typename T>
+        class ShapeWrapper : public IShape
+        {
+            T shape_;
+
+        public:
+            ShapeWrapper(const T& shp)
+                : shape_(shp)
+            {
+            }
+
+            void draw() const override
+            {
+                shape_.draw();
+            }
+
+            void move(int x, int y) override
+            {
+                shape_.move(x, y);
+            }
+
+            std::unique_ptr<IShape> clone() override
+            {
+                return std::make_unique<ShapeWrapper<T>>(shape_);
+            }
+        };
+
+        std::unique_ptr<IShape> shape_;
+
+    public:
+        template <typename T>
+        HeapShape(const T& shp)
+            : shape_(std::make_unique<ShapeWrapper<T>>(shp))
+        {
+        }
+
+        HeapShape(const HeapShape& src)
+            : shape_{src.shape_->clone()}
+        {
+        }
+
+        HeapShape& operator=(const HeapShape& src)
+        {
+            HeapShape temp(src);
+            shape_.swap(temp.shape_);
+
+            return *this;
+        }
+
+        HeapShape(HeapShape&&) noexcept = default;
+        HeapShape& operator=(HeapShape&&) noexcept = default;
+
+        void move(int x, int y)
+        {
+            shape_->move(x, y);
+        }
+    };
+
+#ifdef HAS_FOLLY_POLY
+    struct IPolyShape
+    {
+        template <class Base>
+        struct Interface : Base
+        {
+            void move(int dx, int dy) { folly::poly_call<0>(*this, dx, dy); }
+            void draw() const { folly::poly_call<1>(*this); }
+        };
+
+        template <class T>
+        using Members = folly::PolyMembers<&T::move, &T::draw>;
+    };
+
+    using PolyShape = folly::Poly<IPolyShape>;
+#endif
+
+    template <typename F>
+    double measure(F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    template <typename ShapeType>
+    void run(const std::string& name, std::size_t shape_count)
+    {
+        std::vector<ShapeType> shapes;
+
+        // no reserve - growing the vector moves the shapes
+        const auto fill_allocations = allocation_count.load();
+        auto fill_time = measure([&] {
+            for (std::size_t i = 0; i < shape_count; ++i)
+            {
+                const int n = static_cast<int>(i);
+
+                switch (i % 3)
+                {
+                case 0:
+                    shapes.emplace_back(Circle{n, n, 10});
+                    break;
+                case 1:
+                    shapes.emplace_back(Square{n, n, 20});
+                    break;
+                default:
+                    shapes.emplace_back(Triangle{{Point{n, 0}, Point{0, n}, Point{n, n}}});
+                }
+            }
+        });
+        const auto fill_count = allocation_count.load() - fill_allocations;
+
+        const auto copy_allocations = allocation_count.load();
+        std::vector<ShapeType> copy;
+        auto copy_time = measure([&] { copy = shapes; });
+        const auto copy_count = allocation_count.load() - copy_allocations;
+
+        auto move_time = measure([&] {
+            for (auto& shp : shapes)
+                shp.move(1, 2);
+        });
+
+        auto destroy_time = measure([&] {
+            shapes.clear();
+            copy.clear();
+        });
+
+        std::cout << name << ":\tsizeof: " << sizeof(ShapeType) << " B"
+                  << "\tfill: " << fill_time << " s (" << fill_count << " allocations)"
+                  << "\tcopy: " << copy_time << " s (" << copy_count << " allocations)"
+                  << "\tmove(): " << move_time << " s"
+                  << "\tdestroy: " << destroy_time << " s" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t shape_count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+
+    std::cout << "shapes: " << shape_count << " (Circle, Square, Triangle)" << std::endl;
+
+    run<HeapShape>("heap wrapper", shape_count);
+    run<Shape>("small buffer", shape_count);
+#ifdef HAS_FOLLY_POLY
+    run<PolyShape>("folly::Poly", shape_count);
+#else
+    std::cout << "folly::Poly: not measured - folly was not found" << std::endl;
+#endif
+}
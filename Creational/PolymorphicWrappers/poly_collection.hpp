@@ -0,0 +1,266 @@
+#ifndef POLY_COLLECTION_HPP
+#define POLY_COLLECTION_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Non-owning reference to a shape of any type with draw() const and move(int, int)
+class ShapeRef
+{
+    void* shape_;
+    void (*draw_)(const void* shape);
+    void (*move_)(void* shape, int dx, int dy);
+
+public:
+    template <typename T, typename = std::enable_if_t<!std::is_same_v<T, ShapeRef>>>
+    explicit ShapeRef(T& shp)
+        : shape_{&shp}
+        , draw_{[](const void* shape) { static_cast<const T*>(shape)->draw(); }}
+        , move_{[](void* shape, int dx, int dy) { static_cast<T*>(shape)->move(dx, dy); }}
+    {
+    }
+
+    void draw() const
+    {
+        draw_(shape_);
+    }
+
+    void move(int dx, int dy)
+    {
+        move_(shape_, dx, dy);
+    }
+};
+
+// Container of shapes segmented by their dynamic type (like boost::poly_collection).
+// Shapes of each type are stored by value in their own contiguous segment, so loops
+// over a segment call draw() & move() directly - the calls can be inlined and the
+// branch predictor sees one type at a time. Any type satisfying the shape concept
+// (draw() const, move(int, int)) is accepted.
+//
+// Iteration order: segments in order of the first insertion of their type, shapes of
+// a segment in insertion order.
+class PolyCollection
+{
+    class SegmentBase
+    {
+    public:
+        using Callback = void (*)(void* context, ShapeRef shp);
+
+        virtual ~SegmentBase() = default;
+        virtual std::unique_ptr<SegmentBase> clone() const = 0;
+        virtual std::size_t size() const = 0;
+        virtual void clear() = 0;
+        virtual void draw() const = 0;
+        virtual void move(int dx, int dy) = 0;
+        virtual void for_each(Callback callback, void* context) = 0;
+    };
+
+    template <typename T>
+    class Segment : public SegmentBase
+    {
+    public:
+        std::vector<T> items;
+
+        std::unique_ptr<SegmentBase> clone() const override
+        {
+            return std::make_unique<Segment>(*this);
+        }
+
+        std::size_t size() const override
+        {
+            return items.size();
+        }
+
+        void clear() override
+        {
+            items.clear();
+        }
+
+        void draw() const override
+        {
+            for (const auto& shp : items)
+                shp.draw();
+        }
+
+        void move(int dx, int dy) override
+        {
+            for (auto& shp : items)
+                shp.move(dx, dy);
+        }
+
+        void for_each(Callback callback, void* context) override
+        {
+            for (auto& shp : items)
+                callback(context, ShapeRef{shp});
+        }
+    };
+
+    std::vector<std::unique_ptr<SegmentBase>> segments_;
+    std::vector<std::type_index> segment_types_; // parallel to segments_
+    std::unordered_map<std::type_index, std::size_t> segment_index_;
+
+    template <typename T>
+    Segment<T>* find_segment() const
+    {
+        auto pos = segment_index_.find(std::type_index(typeid(T)));
+
+        return pos != segment_index_.end() ? static_cast<Segment<T>*>(segments_[pos->second].get()) : nullptr;
+    }
+
+    template <typename T>
+    Segment<T>& segment()
+    {
+        if (auto* existing = find_segment<T>())
+            return *existing;
+
+        auto new_segment = std::make_unique<Segment<T>>();
+        auto& result = *new_segment;
+
+        segments_.reserve(segments_.size() + 1);
+        segment_types_.reserve(segment_types_.size() + 1);
+        segment_index_.emplace(std::type_index(typeid(T)), segments_.size());
+
+        // cannot throw after the reservations
+        segment_types_.push_back(std::type_index(typeid(T)));
+        segments_.push_back(std::move(new_segment));
+
+        return result;
+    }
+
+    // calls f with a T& when the segment stores one of Types
+    template <typename F, typename... Types>
+    static bool for_each_restored(SegmentBase& segment, std::type_index type, F& f)
+    {
+        if constexpr (sizeof...(Types) == 0)
+            return false;
+        else
+        {
+            auto visit_if = [&](auto* tag) {
+                using T = std::remove_pointer_t<decltype(tag)>;
+
+                if (type != std::type_index(typeid(T)))
+                    return false;
+
+                for (auto& shp : static_cast<Segment<T>&>(segment).items)
+                    f(shp);
+
+                return true;
+            };
+
+            return (visit_if(static_cast<Types*>(nullptr)) || ...);
+        }
+    }
+
+public:
+    PolyCollection() = default;
+
+    PolyCollection(const PolyCollection& source)
+        : segment_types_{source.segment_types_}
+        , segment_index_{source.segment_index_}
+    {
+        segments_.reserve(source.segments_.size());
+
+        for (const auto& segment : source.segments_)
+            segments_.push_back(segment->clone());
+    }
+
+    PolyCollection& operator=(const PolyCollection& source)
+    {
+        PolyCollection temp(source);
+        swap(temp);
+
+        return *this;
+    }
+
+    PolyCollection(PolyCollection&&) noexcept = default;
+    PolyCollection& operator=(PolyCollection&&) noexcept = default;
+
+    void swap(PolyCollection& other) noexcept
+    {
+        segments_.swap(other.segments_);
+        segment_types_.swap(other.segment_types_);
+        segment_index_.swap(other.segment_index_);
+    }
+
+    // the reference is valid until the next insertion of the same type
+    template <typename T>
+    std::decay_t<T>& insert(T&& shp)
+    {
+        return segment<std::decay_t<T>>().items.emplace_back(std::forward<T>(shp));
+    }
+
+    template <typename T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        return segment<T>().items.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    template <typename T>
+    void reserve(std::size_t count)
+    {
+        segment<T>().items.reserve(count);
+    }
+
+    std::size_t size() const
+    {
+        std::size_t result = 0;
+        for (const auto& segment : segments_)
+            result += segment->size();
+
+        return result;
+    }
+
+    template <typename T>
+    std::size_t size() const
+    {
+        auto* segment = find_segment<T>();
+
+        return segment ? segment->items.size() : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        for (auto& segment : segments_)
+            segment->clear();
+    }
+
+    // one virtual call per segment - the loops inside call the shapes directly
+    void draw() const
+    {
+        for (const auto& segment : segments_)
+            segment->draw();
+    }
+
+    void move(int dx, int dy)
+    {
+        for (auto& segment : segments_)
+            segment->move(dx, dy);
+    }
+
+    // Calls f(T&) for shapes of the restored Types - the calls are resolved statically -
+    // and f(ShapeRef&) for shapes of any other type (so f is usually a generic lambda)
+    template <typename... Types, typename F>
+    void for_each(F f)
+    {
+        for (std::size_t i = 0; i < segments_.size(); ++i)
+        {
+            if (for_each_restored<F, Types...>(*segments_[i], segment_types_[i], f))
+                continue;
+
+            segments_[i]->for_each([](void* context, ShapeRef shp) { (*static_cast<F*>(context))(shp); }, &f);
+        }
+    }
+};
+
+#endif // POLY_COLLECTION_HPP
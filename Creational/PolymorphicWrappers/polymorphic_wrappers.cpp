@@ -4,6 +4,10 @@
 #include <vector>
 #include <variant>
 
+#include "poly_collection.hpp"
+#include "shape.hpp"
+#include "shapes.hpp"
+
 namespace Explain
 {
     template <typename T>
@@ -19,175 +23,6 @@ void explain()
     Explain::foo(x);
 }
 
-class Shape // polymorphic wrapper with type-erasure
-{
-    // shape interface
-    class IShape
-    {
-    public:
-        virtual ~IShape() = default;
-        virtual void move(int x, int y) = 0;
-        virtual void draw() const = 0;
-        virtual std::unique_ptr<IShape> clone() = 0;
-    };
-
-    template <typename T>
-    class ShapeWrapper : public IShape
-    {
-        T shape_;
-
-    public:
-        ShapeWrapper(const T& shp)
-            : shape_(shp)
-        {
-        }
-
-        ShapeWrapper(T&& shp)
-            : shape_(std::move(shp))
-        {
-        }
-
-        void draw() const override
-        {
-            shape_.draw();
-        }
-
-        void move(int x, int y) override
-        {
-            shape_.move(x, y);
-        }
-
-        std::unique_ptr<IShape> clone() override
-        {
-            return std::make_unique<ShapeWrapper<T>>(shape_);
-        }
-    };
-
-public:
-    template <typename T>
-    Shape(T&& shp)
-        : shape_(std::make_unique<ShapeWrapper<std::decay_t<T>>>(std::forward<T>(shp)))
-    {
-    }
-
-    Shape(const Shape& src)
-        : shape_{src.shape_->clone()}
-    {
-    }
-
-    Shape& operator=(const Shape& src)
-    {
-        Shape temp(src);
-        swap(temp);
-
-        return *this;
-    }
-
-    template <class T>
-    Shape& operator=(T&& src)
-    {
-        Shape(std::forward<T>(src)).swap(*this);
-        return *this;
-    }
-
-    Shape(Shape&&) noexcept = default;
-    Shape& operator=(Shape&&) noexcept = default;
-
-    void swap(Shape& other)
-    {
-        shape_.swap(other.shape_);
-    }
-
-    void draw() const
-    {
-        shape_->draw();
-    }
-
-    void move(int x, int y)
-    {
-        shape_->move(x, y);
-    }
-
-private:
-    std::unique_ptr<IShape> shape_;
-};
-
-struct Circle
-{
-    int x, y;
-    int r;
-
-    Circle(int x, int y, int r)
-        : x{x}
-        , y{y}
-        , r{r}
-    {
-    }
-
-    void draw() const
-    {
-        std::cout << "Circle([" << x << ", " << y << "], " << r << ")\n";
-    }
-
-    void move(int dx, int dy)
-    {
-        x += dx;
-        y += dy;
-    }
-};
-
-struct Square
-{
-    int x, y;
-    int size;
-
-    Square(int x, int y, int r)
-        : x{x}
-        , y{y}
-        , size{r}
-    {
-    }
-
-    void draw() const
-    {
-        std::cout << "Square([" << x << ", " << y << "], " << size << ")\n";
-    }
-
-    void move(int dx, int dy)
-    {
-        x += dx;
-        y += dy;
-    }
-};
-
-struct Point
-{
-    int x, y;
-};
-
-struct Triangle
-{
-    std::array<Point, 3> vertices;
-
-    void draw() const
-    {
-        std::cout << "Triangle({ ";
-        for (const Point& v : vertices)
-            std::cout << "[" << v.x << ", " << v.y << "]"
-                      << " ";
-        std::cout << "})\n";
-    }
-
-    void move(int dx, int dy)
-    {
-        for (auto& v : vertices)
-        {
-            v.x += dx;
-            v.y += dy;
-        }
-    }
-};
-
 class GraphicsDoc
 {
     std::vector<Shape> shapes_;
@@ -202,7 +37,7 @@ public:
 
     void add(Shape shp)
     {
-        shapes_.push_back(shp);
+        shapes_.push_back(std::move(shp));
     }
 
     void draw() const
@@ -271,4 +106,18 @@ int main(int argc, char* argv[])
     std::cout << "\n\nMoving coordinates:\n";
     doc.move(1, 2);
     doc.draw();
-}
\ No newline at end of file
+
+    std::cout << "\n\nShapes segmented by type:\n";
+
+    PolyCollection collection;
+    collection.insert(Circle(1, 2, 10));
+    collection.insert(Square(50, 10, 120));
+    collection.insert(Circle(100, 200, 2));
+    collection.insert(Triangle{{Point{0, 10}, Point{10, 20}, Point{40, 70}}});
+    collection.insert(Square(10, 20, 300));
+    collection.draw();
+
+    std::cout << "\n\nMoving circles & squares (type restored) and other shapes:\n";
+    collection.for_each<Circle, Square>([](auto& shp) { shp.move(1, 2); });
+    collection.for_each([](auto& shp) { shp.draw(); });
+}
@@ -0,0 +1,216 @@
+#ifndef SHAPE_HPP
+#define SHAPE_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Polymorphic wrapper with type-erasure. Any type with draw() const and move(int, int)
+// can be stored by value.
+//
+// Shapes up to Capacity bytes (with an alignment dividing Alignment and a noexcept move
+// constructor) are stored in a buffer inside the wrapper - larger ones on the heap.
+// Operations are dispatched through a static table of function pointers per stored type
+// (no virtual inheritance), so moves of inline shapes only relocate the bytes of the shape
+// and never allocate.
+template <std::size_t Capacity = 4 * sizeof(void*), std::size_t Alignment = alignof(void*)>
+class BasicShape
+{
+    static_assert(Capacity >= sizeof(void*) && Alignment % alignof(void*) == 0,
+        "The buffer must be able to hold a pointer to a shape stored on the heap");
+
+    struct VTable
+    {
+        void (*draw)(const void* storage);
+        void (*move)(void* storage, int dx, int dy);
+        void (*copy)(const void* source, void* target);         // constructs a copy in target
+        void (*relocate)(void* source, void* target) noexcept; // moves to target & destroys source
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename T>
+    struct InlineModel
+    {
+        static T& get(void* storage)
+        {
+            return *std::launder(static_cast<T*>(storage));
+        }
+
+        static const T& get(const void* storage)
+        {
+            return *std::launder(static_cast<const T*>(storage));
+        }
+
+        static void draw(const void* storage)
+        {
+            get(storage).draw();
+        }
+
+        static void move(void* storage, int dx, int dy)
+        {
+            get(storage).move(dx, dy);
+        }
+
+        static void copy(const void* source, void* target)
+        {
+            ::new (target) T(get(source));
+        }
+
+        static void relocate(void* source, void* target) noexcept
+        {
+            T& shp = get(source);
+            ::new (target) T(std::move(shp));
+            shp.~T();
+        }
+
+        static void destroy(void* storage) noexcept
+        {
+            get(storage).~T();
+        }
+    };
+
+    template <typename T>
+    struct HeapModel
+    {
+        static T* get(const void* storage)
+        {
+            return *std::launder(static_cast<T* const*>(storage));
+        }
+
+        static void draw(const void* storage)
+        {
+            get(storage)->draw();
+        }
+
+        static void move(void* storage, int dx, int dy)
+        {
+            get(storage)->move(dx, dy);
+        }
+
+        static void copy(const void* source, void* target)
+        {
+            ::new (target) T*(new T(*get(source)));
+        }
+
+        static void relocate(void* source, void* target) noexcept
+        {
+            ::new (target) T*(get(source));
+        }
+
+        static void destroy(void* storage) noexcept
+        {
+            delete get(storage);
+        }
+    };
+
+    template <typename Model>
+    static constexpr VTable vtable_of = {&Model::draw, &Model::move, &Model::copy, &Model::relocate, &Model::destroy};
+
+    template <typename T>
+    using EnableIfNotShape = std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicShape>>;
+
+public:
+    template <typename T>
+    static constexpr bool is_stored_inline = sizeof(T) <= Capacity && Alignment % alignof(T) == 0
+        && std::is_nothrow_move_constructible_v<T>;
+
+    template <typename T, typename = EnableIfNotShape<T>>
+    BasicShape(T&& shp)
+    {
+        using ShapeType = std::decay_t<T>;
+
+        if constexpr (is_stored_inline<ShapeType>)
+        {
+            ::new (static_cast<void*>(storage_)) ShapeType(std::forward<T>(shp));
+            vtable_ = &vtable_of<InlineModel<ShapeType>>;
+        }
+        else
+        {
+            ::new (static_cast<void*>(storage_)) ShapeType*(new ShapeType(std::forward<T>(shp)));
+            vtable_ = &vtable_of<HeapModel<ShapeType>>;
+        }
+    }
+
+    BasicShape(const BasicShape& source)
+    {
+        if (source.vtable_)
+            source.vtable_->copy(source.storage_, storage_);
+
+        vtable_ = source.vtable_;
+    }
+
+    // the source is left empty
+    BasicShape(BasicShape&& source) noexcept
+    {
+        if (source.vtable_)
+            source.vtable_->relocate(source.storage_, storage_);
+
+        vtable_ = std::exchange(source.vtable_, nullptr);
+    }
+
+    BasicShape& operator=(const BasicShape& source)
+    {
+        BasicShape temp(source);
+        swap(temp);
+
+        return *this;
+    }
+
+    BasicShape& operator=(BasicShape&& source) noexcept
+    {
+        if (this != &source)
+        {
+            reset();
+
+            if (source.vtable_)
+                source.vtable_->relocate(source.storage_, storage_);
+
+            vtable_ = std::exchange(source.vtable_, nullptr);
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename = EnableIfNotShape<T>>
+    BasicShape& operator=(T&& src)
+    {
+        return *this = BasicShape(std::forward<T>(src));
+    }
+
+    ~BasicShape()
+    {
+        reset();
+    }
+
+    void swap(BasicShape& other) noexcept
+    {
+        BasicShape temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    void draw() const
+    {
+        vtable_->draw(storage_);
+    }
+
+    void move(int x, int y)
+    {
+        vtable_->move(storage_, x, y);
+    }
+
+private:
+    alignas(Alignment) unsigned char storage_[Capacity];
+    const VTable* vtable_ = nullptr;
+
+    void reset() noexcept
+    {
+        if (vtable_)
+            std::exchange(vtable_, nullptr)->destroy(storage_);
+    }
+};
+
+using Shape = BasicShape<>;
+
+#endif // SHAPE_HPP
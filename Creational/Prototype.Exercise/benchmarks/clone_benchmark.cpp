@@ -0,0 +1,83 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rectangle.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Prototype.Exercise_clone_benchmark [clone_count]
+
+namespace
+{
+    template <typename F>
+    double measure(F&& f)
+    {
+        auto start = chrono::steady_clock::now();
+        f();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    // tiling - every copy of the prototype is moved to its own cell
+    void lay_out(Shape& shp, size_t index)
+    {
+        shp.move(static_cast<int>(index % 1000) * 20, static_cast<int>(index / 1000) * 10);
+    }
+
+    void report(const string& name, double clone_time, double destroy_time, size_t clone_count)
+    {
+        cout << name << ":\tclone: " << clone_time << " s"
+             << "\tdestroy: " << destroy_time << " s"
+             << "\tclones/s: " << static_cast<size_t>(clone_count / clone_time) << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t clone_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+
+    const Rectangle tile{0, 0, 20, 10};
+    const Shape& prototype = tile;
+
+    cout << "clones: " << clone_count << endl;
+
+    {
+        vector<unique_ptr<Shape>> clones;
+        clones.reserve(clone_count);
+
+        auto clone_time = measure([&] {
+            for (size_t i = 0; i < clone_count; ++i)
+            {
+                clones.push_back(prototype.clone());
+                lay_out(*clones.back(), i);
+            }
+        });
+
+        auto destroy_time = measure([&] { clones.clear(); });
+
+        report("clone()", clone_time, destroy_time, clone_count);
+    }
+
+    {
+        vector<Shape*> clones;
+        clones.reserve(clone_count);
+        ShapeBlock block;
+
+        auto clone_time = measure([&] {
+            block = prototype.clone_n(clone_count, back_inserter(clones));
+
+            for (size_t i = 0; i < clones.size(); ++i)
+                lay_out(*clones[i], i);
+        });
+
+        auto destroy_time = measure([&] {
+            clones.clear();
+            block = ShapeBlock{};
+        });
+
+        report("clone_n()", clone_time, destroy_time, clone_count);
+    }
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "circle.hpp"
+#include "parallel_loader.hpp"
+#include "rectangle.hpp"
+#include "square.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Prototype.Exercise_parallel_load_benchmark [shape_count] [max_threads]
+
+namespace
+{
+    void generate_drawing(const string& filename, size_t shape_count)
+    {
+        mt19937 rnd{42};
+        uniform_int_distribution<int> coord{-10'000, 10'000};
+        uniform_int_distribution<int> size{1, 500};
+
+        ofstream file_out{filename};
+
+        for (size_t i = 0; i < shape_count; ++i)
+        {
+            switch (i % 3)
+            {
+            case 0:
+                file_out << Rectangle::id << " [" << coord(rnd) << "," << coord(rnd) << "] " << size(rnd) << " " << size(rnd) << "\n";
+                break;
+            case 1:
+                file_out << Square::id << " [" << coord(rnd) << "," << coord(rnd) << "] " << size(rnd) << "\n";
+                break;
+            default:
+                file_out << Circle::id << " [" << coord(rnd) << "," << coord(rnd) << "] " << size(rnd) << "\n";
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t shape_count = argc > 1 ? stoul(argv[1]) : 10'000'000;
+    const unsigned int max_threads = argc > 2 ? stoul(argv[2]) : max(1u, thread::hardware_concurrency());
+
+    const string filename = "parallel_load_benchmark.txt";
+
+    cout << "Generating " << shape_count << " shapes..." << endl;
+    generate_drawing(filename, shape_count);
+
+    double single_thread_time = 0.0;
+
+    for (unsigned int thread_count = 1; thread_count <= max_threads; ++thread_count)
+    {
+        auto start = chrono::steady_clock::now();
+
+        auto shapes = IO::load_parallel(filename, SingletonShapeTypeRegistry::instance(), thread_count);
+
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if (thread_count == 1)
+            single_thread_time = elapsed;
+
+        cout << "threads: " << thread_count
+             << "\ttime: " << elapsed << " s"
+             << "\tshapes/s: " << static_cast<size_t>(shapes.size() / elapsed)
+             << "\tspeedup: " << single_thread_time / elapsed << endl;
+
+        if (shapes.size() != shape_count)
+        {
+            cerr << "Loaded " << shapes.size() << " shapes instead of " << shape_count << endl;
+            return 1;
+        }
+    }
+
+    remove(filename.c_str());
+}
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "circle.hpp"
+#include "graphics_doc.hpp"
+#include "rectangle.hpp"
+#include "square.hpp"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Prototype.Exercise_snapshot_benchmark [shape_count] [snapshot_count] [deep|cow]
+//  - without a mode both modes are measured, each in a separate process (so RSS numbers do not interfere)
+
+namespace
+{
+    // resident set size of the process in bytes (0 when not available)
+    size_t resident_memory()
+    {
+#ifdef __linux__
+        ifstream statm{"/proc/self/statm"};
+        size_t total_pages = 0, resident_pages = 0;
+        statm >> total_pages >> resident_pages;
+
+        return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    GraphicsDoc generate_doc(size_t shape_count)
+    {
+        mt19937 rnd{42};
+        uniform_int_distribution<int> coord{-10'000, 10'000};
+        uniform_int_distribution<int> size{1, 500};
+
+        GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+        for (size_t i = 0; i < shape_count; ++i)
+        {
+            switch (i % 3)
+            {
+            case 0:
+                doc.add(make_unique<Rectangle>(coord(rnd), coord(rnd), size(rnd), size(rnd)));
+                break;
+            case 1:
+                doc.add(make_unique<Square>(coord(rnd), coord(rnd), size(rnd)));
+                break;
+            default:
+                doc.add(make_unique<Circle>(coord(rnd), coord(rnd), size(rnd)));
+            }
+        }
+
+        return doc;
+    }
+
+    // what GraphicsDoc's copy constructor did before snapshots
+    vector<unique_ptr<Shape>> deep_copy(const GraphicsDoc& doc)
+    {
+        vector<unique_ptr<Shape>> shapes;
+        shapes.reserve(doc.size());
+
+        for (size_t i = 0; i < doc.size(); ++i)
+            shapes.push_back(doc.shape(i).clone());
+
+        return shapes;
+    }
+
+    template <typename F>
+    double measure(F&& f)
+    {
+        auto start = chrono::steady_clock::now();
+        f();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    void run(const string& mode, size_t shape_count, size_t snapshot_count)
+    {
+        auto doc = generate_doc(shape_count);
+
+        // between snapshots the user edits 1% of the shapes
+        const size_t edits_per_snapshot = max<size_t>(1, shape_count / 100);
+        mt19937 rnd{7};
+        uniform_int_distribution<size_t> shape_index{0, shape_count - 1};
+
+        vector<vector<unique_ptr<Shape>>> deep_snapshots;
+        vector<GraphicsDoc> cow_snapshots;
+
+        const size_t rss_before = resident_memory();
+        double snapshot_time = 0.0, edit_time = 0.0;
+
+        for (size_t i = 0; i < snapshot_count; ++i)
+        {
+            if (mode == "deep")
+                snapshot_time += measure([&] { deep_snapshots.push_back(deep_copy(doc)); });
+            else
+                snapshot_time += measure([&] { cow_snapshots.push_back(doc.snapshot()); });
+
+            edit_time += measure([&] {
+                for (size_t e = 0; e < edits_per_snapshot; ++e)
+                    doc.move(shape_index(rnd), 1, 1);
+            });
+        }
+
+        const size_t rss_after = resident_memory();
+
+        cout << mode << ":\tsnapshot: " << snapshot_time / snapshot_count * 1e3 << " ms"
+             << "\tedits after snapshot: " << edit_time / snapshot_count * 1e3 << " ms"
+             << "\tmemory per snapshot: " << (rss_after - rss_before) / snapshot_count / 1024 << " KiB" << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const string shape_count = argc > 1 ? argv[1] : "1000000";
+    const string snapshot_count = argc > 2 ? argv[2] : "20";
+
+    if (argc > 3)
+    {
+        run(argv[3], stoul(shape_count), stoul(snapshot_count));
+        return 0;
+    }
+
+    cout << "shapes: " << shape_count << "\tsnapshots: " << snapshot_count << " (1% of shapes edited after each)" << endl;
+
+    int result = 0;
+    for (const char* mode : {"deep", "cow"})
+        result |= system((string("\"") + argv[0] + "\" " + shape_count + " " + snapshot_count + " " + mode).c_str());
+
+    return result;
+}
@@ -0,0 +1,97 @@
+#include "graphics_doc.hpp"
+#include "parallel_loader.hpp"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+using namespace Drawing;
+
+GraphicsDoc::GraphicsDoc(const ShapeTypeRegistry& shape_types)
+    : shape_types_{shape_types}, shapes_{make_shared<ShapeList>()}
+{
+}
+
+GraphicsDoc::ShapeList& GraphicsDoc::mutable_shapes()
+{
+    // the handle vector is shared with a snapshot - copy the handles (not the shapes);
+    // use_count() is reliable only because snapshots stay on the thread of the document
+    if (shapes_.use_count() > 1)
+        shapes_ = make_shared<ShapeList>(*shapes_);
+
+    // the vector is owned exclusively - it was created non-const by this document
+    return const_cast<ShapeList&>(*shapes_);
+}
+
+Shape& GraphicsDoc::mutable_shape(size_t index)
+{
+    auto& handle = mutable_shapes().at(index);
+
+    // the shape is shared with a snapshot - clone on write
+    if (handle.use_count() > 1)
+        handle = handle->clone();
+
+    // every shape is created non-const and only exposed as const
+    return const_cast<Shape&>(*handle);
+}
+
+void GraphicsDoc::add(unique_ptr<Shape> shp)
+{
+    mutable_shapes().push_back(std::move(shp));
+}
+
+void GraphicsDoc::render()
+{
+    for (const auto& shp : *shapes_)
+        shp->draw();
+}
+
+void GraphicsDoc::load(const string& filename)
+{
+    ifstream file_in{filename};
+
+    if (!file_in)
+    {
+        cout << "File not found!" << endl;
+        exit(1);
+    }
+
+    auto& shapes = mutable_shapes();
+
+    while (file_in)
+    {
+        string shape_id;
+        file_in >> shape_id;
+
+        if (!file_in)
+            return;
+
+        cout << "Loading " << shape_id << "..." << endl;
+
+        const auto& shape_type = shape_types_.find(shape_id);
+
+        auto shape = shape_type.create();
+        shape_type.shape_rw->read(*shape, file_in);
+
+        shapes.push_back(std::move(shape));
+    }
+}
+
+void GraphicsDoc::load_parallel(const string& filename, unsigned int thread_count)
+{
+    auto loaded_shapes = IO::load_parallel(filename, shape_types_, thread_count);
+
+    auto& shapes = mutable_shapes();
+    shapes.reserve(shapes.size() + loaded_shapes.size());
+
+    for (auto& shp : loaded_shapes)
+        shapes.push_back(std::move(shp));
+}
+
+void GraphicsDoc::save(const string& filename)
+{
+    ofstream file_out{filename};
+
+    for (const auto& shp : *shapes_)
+        shape_types_.find(*shp).shape_rw->write(*shp, file_out);
+}
@@ -0,0 +1,73 @@
+#ifndef GRAPHICS_DOC_HPP
+#define GRAPHICS_DOC_HPP
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shape.hpp"
+#include "shape_type_registry.hpp"
+
+// Shapes of a document are immutable and shared by copies of the document (snapshots).
+// A copy costs one reference count increment; a document copies the handle vector on its
+// first change after a snapshot and clones a shape only when it changes a shared one.
+// A document and all its snapshots must be used by a single thread: an exclusive owner is
+// detected with shared_ptr::use_count(), which gives no ordering with releases made by other
+// threads (e.g. a snapshot dropped by an autosave thread could still be read while this
+// document mutates the shape in place).
+class GraphicsDoc
+{
+public:
+    using ShapeList = std::vector<std::shared_ptr<const Drawing::Shape>>;
+
+private:
+    const Drawing::ShapeTypeRegistry& shape_types_;
+    std::shared_ptr<const ShapeList> shapes_;
+
+    ShapeList& mutable_shapes();
+    Drawing::Shape& mutable_shape(std::size_t index);
+
+public:
+    explicit GraphicsDoc(const Drawing::ShapeTypeRegistry& shape_types);
+
+    // O(1) snapshot - no shape is cloned
+    GraphicsDoc(const GraphicsDoc&) = default;
+
+    GraphicsDoc snapshot() const
+    {
+        return *this;
+    }
+
+    std::size_t size() const
+    {
+        return shapes_->size();
+    }
+
+    const Drawing::Shape& shape(std::size_t index) const
+    {
+        return *shapes_->at(index);
+    }
+
+    void add(std::unique_ptr<Drawing::Shape> shp);
+
+    // calls modifier(Drawing::Shape&) on a shape not shared with any snapshot
+    template <typename Modifier>
+    void modify(std::size_t index, Modifier modifier)
+    {
+        modifier(mutable_shape(index));
+    }
+
+    void move(std::size_t index, int dx, int dy)
+    {
+        modify(index, [=](Drawing::Shape& shp) { shp.move(dx, dy); });
+    }
+
+    void render();
+
+    void load(const std::string& filename);
+    void load_parallel(const std::string& filename, unsigned int thread_count = std::thread::hardware_concurrency());
+    void save(const std::string& filename);
+};
+
+#endif // GRAPHICS_DOC_HPP
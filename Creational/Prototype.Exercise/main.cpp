@@ -1,99 +1,16 @@
 #include <cassert>
-#include <fstream>
-#include <functional>
 #include <iostream>
-#include <memory>
-#include <typeindex>
-#include <unordered_map>
-#include <vector>
 
-#include "shape.hpp"
-#include "shape_factories.hpp"
+#include "graphics_doc.hpp"
 
 using namespace std;
 using namespace Drawing;
-using namespace Drawing::IO;
-
-class GraphicsDoc
-{
-    vector<unique_ptr<Shape>> shapes_;
-    ShapeFactory& shape_factory_;
-    ShapeRWFactory& shape_rw_factory_;
-
-public:
-    GraphicsDoc(ShapeFactory& shape_factory, ShapeRWFactory& shape_rw_factory)
-        : shape_factory_{shape_factory}
-        , shape_rw_factory_{shape_rw_factory}
-    {
-    }
-
-    GraphicsDoc(GraphicsDoc const& rhs)
-        : shape_factory_(rhs.shape_factory_)
-        , shape_rw_factory_(rhs.shape_rw_factory_)
-    {
-        for (auto const& shape : rhs.shapes_)
-        {
-            shapes_.emplace_back(shape->clone());
-        }
-    }
-
-    void add(unique_ptr<Shape> shp)
-    {
-        shapes_.push_back(std::move(shp));
-    }
-
-    void render()
-    {
-        for (const auto& shp : shapes_)
-            shp->draw();
-    }
-
-    void load(const string& filename)
-    {
-        ifstream file_in{filename};
-
-        if (!file_in)
-        {
-            cout << "File not found!" << endl;
-            exit(1);
-        }
-
-        while (file_in)
-        {
-            string shape_id;
-            file_in >> shape_id;
-
-            if (!file_in)
-                return;
-
-            cout << "Loading " << shape_id << "..." << endl;
-
-            auto shape = shape_factory_.create(shape_id);
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shape));
-
-            shape_rw->read(*shape, file_in);
-
-            shapes_.push_back(std::move(shape));
-        }
-    }
-
-    void save(const string& filename)
-    {
-        ofstream file_out{filename};
-
-        for (const auto& shp : shapes_)
-        {
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shp));
-            shape_rw->write(*shp, file_out);
-        }
-    }
-};
 
 int main()
 {
     cout << "Start..." << endl;
 
-    GraphicsDoc doc(SingletonShapeFactory::instance(), SingletonShapeRWFactory::instance());
+    GraphicsDoc doc(SingletonShapeTypeRegistry::instance());
 
     doc.load("drawing_prototype_exercise.txt");
 
@@ -103,9 +20,19 @@ int main()
 
     cout << "\n";
 
-    GraphicsDoc doc2 = doc;
+    GraphicsDoc doc2 = doc; // snapshot - shapes are shared until modified
+
+    doc2.move(0, 10, 10); // clones the first shape only
 
     doc2.render();
 
     doc2.save("new_drawing.txt");
+
+    cout << "\n";
+
+    GraphicsDoc doc3(SingletonShapeTypeRegistry::instance());
+
+    doc3.load_parallel("drawing_prototype_exercise.txt");
+
+    doc3.render();
 }
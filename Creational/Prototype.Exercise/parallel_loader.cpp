@@ -0,0 +1,156 @@
+#include "parallel_loader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <stdexcept>
+#include <streambuf>
+#include <string_view>
+#include <utility>
+
+using namespace std;
+using namespace Drawing;
+using namespace Drawing::IO;
+
+namespace
+{
+    // read-only stream buffer over a chunk of memory - no copying of the chunk
+    class MemoryBuffer : public std::streambuf
+    {
+    public:
+        MemoryBuffer(const char* begin, const char* end)
+        {
+            char* first = const_cast<char*>(begin);
+            setg(first, first, first + (end - begin));
+        }
+    };
+
+    // the registry is only read during loading - it is shared by all workers
+    vector<unique_ptr<Shape>> parse_chunk(string_view chunk, const ShapeTypeRegistry& shape_types)
+    {
+        MemoryBuffer buffer{chunk.data(), chunk.data() + chunk.size()};
+        istream in{&buffer};
+
+        vector<unique_ptr<Shape>> shapes;
+        string shape_id;
+
+        while (in >> shape_id)
+        {
+            const auto& shape_type = shape_types.find(shape_id);
+
+            auto shape = shape_type.create();
+            shape_type.shape_rw->read(*shape, in);
+
+            shapes.push_back(std::move(shape));
+        }
+
+        return shapes;
+    }
+
+    // chunk boundaries are moved forward to the next end of line
+    vector<string_view> split_into_chunks(string_view content, size_t chunk_count)
+    {
+        vector<string_view> chunks;
+        const size_t approx_chunk_size = max<size_t>(1, content.size() / chunk_count);
+
+        size_t start = 0;
+        while (start < content.size())
+        {
+            size_t end = start + approx_chunk_size;
+
+            if (end >= content.size())
+                end = content.size();
+            else
+            {
+                end = content.find('\n', end);
+                end = (end == string_view::npos) ? content.size() : end + 1;
+            }
+
+            chunks.push_back(content.substr(start, end - start));
+            start = end;
+        }
+
+        return chunks;
+    }
+}
+
+vector<unique_ptr<Shape>> Drawing::IO::load_parallel(const string& filename,
+    const ShapeTypeRegistry& shape_types, unsigned int thread_count)
+{
+    ifstream file_in{filename, ios::binary | ios::ate};
+
+    if (!file_in)
+        throw runtime_error("File not found: " + filename);
+
+    string content(static_cast<size_t>(file_in.tellg()), '\0');
+    file_in.seekg(0);
+    file_in.read(content.data(), content.size());
+
+    if (!file_in)
+        throw runtime_error("Error while reading file: " + filename);
+
+    thread_count = max(1u, thread_count);
+
+    // a few chunks per thread to even out the load between workers
+    const auto chunks = split_into_chunks(content, thread_count * 4);
+    vector<vector<unique_ptr<Shape>>> results(chunks.size());
+
+    atomic<size_t> next_chunk{0};
+    vector<exception_ptr> errors(thread_count);
+
+    auto worker = [&](unsigned int worker_id) {
+        try
+        {
+            for (size_t i = next_chunk++; i < chunks.size(); i = next_chunk++)
+                results[i] = parse_chunk(chunks[i], shape_types);
+        }
+        catch (...)
+        {
+            errors[worker_id] = current_exception();
+            next_chunk = chunks.size(); // stop the other workers
+        }
+    };
+
+    vector<thread> workers;
+    auto join_all = [&workers] {
+        for (auto& t : workers)
+            t.join();
+    };
+
+    try
+    {
+        for (unsigned int i = 1; i < thread_count; ++i)
+            workers.emplace_back(worker, i);
+    }
+    catch (...)
+    {
+        // joinable threads must not be destroyed - stop and join the started ones
+        next_chunk = chunks.size();
+        join_all();
+        throw;
+    }
+
+    worker(0);
+
+    join_all();
+
+    for (const auto& error : errors)
+        if (error)
+            rethrow_exception(error);
+
+    // splice chunk results in file order
+    size_t total_count = 0;
+    for (const auto& chunk_shapes : results)
+        total_count += chunk_shapes.size();
+
+    vector<unique_ptr<Shape>> shapes;
+    shapes.reserve(total_count);
+
+    for (auto& chunk_shapes : results)
+        move(chunk_shapes.begin(), chunk_shapes.end(), back_inserter(shapes));
+
+    return shapes;
+}
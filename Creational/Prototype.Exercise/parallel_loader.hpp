@@ -0,0 +1,24 @@
+#ifndef PARALLEL_LOADER_HPP
+#define PARALLEL_LOADER_HPP
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "shape.hpp"
+#include "shape_type_registry.hpp"
+
+namespace Drawing
+{
+    namespace IO
+    {
+        // Loads a text drawing using several threads. The file is split into chunks
+        // at record (line) boundaries, chunks are parsed concurrently and shapes are
+        // returned in file order.
+        std::vector<std::unique_ptr<Shape>> load_parallel(const std::string& filename,
+            const ShapeTypeRegistry& shape_types, unsigned int thread_count = std::thread::hardware_concurrency());
+    }
+}
+
+#endif // PARALLEL_LOADER_HPP
@@ -3,10 +3,96 @@
 
 #include "point.hpp"
 
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
 
 namespace Drawing
 {
+    class Shape;
+
+    // Contiguous block of shapes of one type created by Shape::clone_n() -
+    // owns the shapes and returns the memory to the resource it was allocated from
+    class ShapeBlock
+    {
+    public:
+        // operations of the type stored in a block
+        struct Layout
+        {
+            std::size_t size;
+            std::size_t alignment;
+            Shape* (*at)(void* memory, std::size_t index);
+            void (*destroy_n)(void* memory, std::size_t count) noexcept;
+        };
+
+        ShapeBlock() = default;
+
+        ShapeBlock(std::pmr::memory_resource* resource, void* memory, std::size_t count, const Layout* layout) noexcept
+            : resource_{resource}, memory_{memory}, count_{count}, layout_{layout}
+        {
+        }
+
+        ShapeBlock(const ShapeBlock&) = delete;
+        ShapeBlock& operator=(const ShapeBlock&) = delete;
+
+        ShapeBlock(ShapeBlock&& source) noexcept
+            : resource_{source.resource_}
+            , memory_{std::exchange(source.memory_, nullptr)}
+            , count_{std::exchange(source.count_, 0)}
+            , layout_{source.layout_}
+        {
+        }
+
+        ShapeBlock& operator=(ShapeBlock&& source) noexcept
+        {
+            ShapeBlock temp{std::move(source)};
+            swap(temp);
+
+            return *this;
+        }
+
+        ~ShapeBlock()
+        {
+            if (memory_)
+            {
+                layout_->destroy_n(memory_, count_);
+                resource_->deallocate(memory_, count_ * layout_->size, layout_->alignment);
+            }
+        }
+
+        void swap(ShapeBlock& other) noexcept
+        {
+            std::swap(resource_, other.resource_);
+            std::swap(memory_, other.memory_);
+            std::swap(count_, other.count_);
+            std::swap(layout_, other.layout_);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return count_;
+        }
+
+        bool empty() const noexcept
+        {
+            return count_ == 0;
+        }
+
+        Shape& operator[](std::size_t index) const
+        {
+            return *layout_->at(memory_, index);
+        }
+
+    private:
+        std::pmr::memory_resource* resource_ = nullptr;
+        void* memory_ = nullptr;
+        std::size_t count_ = 0;
+        const Layout* layout_ = nullptr;
+    };
+
     class Shape
     {
     public:
@@ -14,8 +100,45 @@ namespace Drawing
         virtual void move(int x, int y) = 0;
         virtual void draw() const = 0;
         virtual std::unique_ptr<Shape> clone() const = 0;
+
+        // Creates count copies of the shape in one allocation from the resource and writes
+        // a Shape* to each of them to out - one virtual call for the whole batch.
+        // The copies live as long as the returned block.
+        template <typename OutputIterator>
+        ShapeBlock clone_n(std::size_t count, OutputIterator out,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const
+        {
+            ShapeBlock block = clone_block(count, resource);
+
+            for (std::size_t i = 0; i < block.size(); ++i)
+                *out++ = &block[i];
+
+            return block;
+        }
+
+    protected:
+        virtual ShapeBlock clone_block(std::size_t count, std::pmr::memory_resource* resource) const = 0;
     };
 
+    namespace Details
+    {
+        template <typename TShape>
+        struct ShapeBlockLayout
+        {
+            static Shape* at(void* memory, std::size_t index)
+            {
+                return static_cast<TShape*>(memory) + index;
+            }
+
+            static void destroy_n(void* memory, std::size_t count) noexcept
+            {
+                std::destroy_n(static_cast<TShape*>(memory), count);
+            }
+
+            static constexpr ShapeBlock::Layout layout = {sizeof(TShape), alignof(TShape), &at, &destroy_n};
+        };
+    }
+
     template <typename TShape, typename TBaseShape = Shape>
     class CloneableShape : public TBaseShape
     {
@@ -24,6 +147,32 @@ namespace Drawing
         {
             return std::make_unique<TShape>(static_cast<const TShape&>(*this));
         }
+
+    protected:
+        ShapeBlock clone_block(std::size_t count, std::pmr::memory_resource* resource) const override
+        {
+            if (count == 0)
+                return ShapeBlock{};
+
+            if (count > std::numeric_limits<std::size_t>::max() / sizeof(TShape))
+                throw std::bad_array_new_length{};
+
+            // the copies are constructed in a loop the compiler sees through - no virtual call
+            // or allocation per copy (shapes are polymorphic, so never trivially copyable)
+            TShape* copies = static_cast<TShape*>(resource->allocate(count * sizeof(TShape), alignof(TShape)));
+
+            try
+            {
+                std::uninitialized_fill_n(copies, count, static_cast<const TShape&>(*this));
+            }
+            catch (...)
+            {
+                resource->deallocate(copies, count * sizeof(TShape), alignof(TShape));
+                throw;
+            }
+
+            return ShapeBlock{resource, copies, count, &Details::ShapeBlockLayout<TShape>::layout};
+        }
     };
 
     template<typename TShape>
@@ -1,6 +1,7 @@
 #include "rectangle_reader_writer.hpp"
 #include "../rectangle.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -10,6 +11,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Rectangle>(), [] { return make_unique<RectangleReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Rectangle, RectangleReaderWriter>();
 }
 
 void RectangleReaderWriter::read(Shape& shp, std::istream& in)
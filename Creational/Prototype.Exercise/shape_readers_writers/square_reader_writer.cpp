@@ -1,5 +1,6 @@
 #include "square_reader_writer.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
 #include "../square.hpp"
 
 using namespace std;
@@ -10,6 +11,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Square>(), &make_unique<SquareReaderWriter>);
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Square, SquareReaderWriter>();
 }
 
 void SquareReaderWriter::read(Shape& shp, istream& in)
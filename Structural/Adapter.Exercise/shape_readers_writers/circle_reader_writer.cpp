@@ -1,6 +1,7 @@
 #include "circle_reader_writer.hpp"
 #include "../circle.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -10,6 +11,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Circle>(), [] { return make_unique<CircleReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Circle, CircleReaderWriter>();
 }
 
 void CircleReaderWriter::read(Shape& shp, std::istream& in)
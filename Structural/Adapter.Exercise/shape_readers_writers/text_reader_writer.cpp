@@ -1,17 +1,36 @@
 #include "text_reader_writer.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
 #include "../text.hpp"
 
 using namespace std;
 using namespace Drawing;
 using namespace IO;
 
-// TODO - register creator for a TextReaderWriter class
+namespace
+{
+    bool is_registered = SingletonShapeRWFactory::instance()
+                             .register_creator(make_type_index<Text>(), [] { return make_unique<TextReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Text, TextReaderWriter>();
+}
 
 void TextReaderWriter::read(Shape& shp, istream& in)
 {
+    Text& text = static_cast<Text&>(shp);
+
+    Point pt;
+    string content;
+
+    in >> pt >> content;
+
+    text.set_coord(pt);
+    text.set_content(content);
 }
 
 void TextReaderWriter::write(const Shape& shp, ostream& out)
 {
+    const Text& text = static_cast<const Text&>(shp);
+
+    out << Text::id << " " << text.coord() << " " << text.content() << "\n";
 }
@@ -10,22 +10,23 @@ namespace
                              .register_creator(Text::id, &make_unique<Text>);
 }
 
-Text::Text(int x, int y, const string& text)
-    : ShapeBase{x, y}, LegacyCode::Paragraph(text.c_str())
+Text::Text(int x, int y, string_view text)
+    : ShapeBase{x, y}, content_{TextPool::instance().intern(text)}
 {
 }
 
+// the adaptee renders the text - its Paragraph lives only for the duration of the call
 void Text::draw() const
 {
-    render_at(coord().x, coord().y);
+    paragraph().render_at(coord().x, coord().y);
 }
 
-string Text::content() const
+void Text::set_content(string_view text)
 {
-    return get_paragraph();
+    content_ = TextPool::instance().intern(text);
 }
 
-void Text::set_content(const string& text)
+LegacyCode::Paragraph Text::paragraph() const
 {
-    set_paragraph(text.c_str());
-}
\ No newline at end of file
+    return LegacyCode::Paragraph{content_.str().substr(0, legacy_max_length).c_str()};
+}
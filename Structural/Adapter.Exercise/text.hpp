@@ -3,23 +3,38 @@
 
 #include "paragraph.hpp"
 #include "shape.hpp"
+#include "text_pool.hpp"
 #include <string>
+#include <string_view>
 
 namespace Drawing
 {
-    // TODO - zaadaptowac klase Paragraph do wymogow klienta
-    class Text : public ShapeBase, private LegacyCode::Paragraph
+    // Object adapter of LegacyCode::Paragraph. The content is interned in the TextPool,
+    // so a Text holds just a handle of a label shared by all shapes with the same content;
+    // a Paragraph (with its 1 KiB buffer) is materialized only while drawing or for legacy code.
+    class Text : public ShapeBase
     {
+        TextPool::Handle content_;
+
     public:
         static constexpr const char* id = "Text";
 
-        Text(int x = 0, int y = 0, const std::string& text = "");
+        // longest content a LegacyCode::Paragraph can hold
+        static constexpr std::size_t legacy_max_length = 1023;
+
+        Text(int x = 0, int y = 0, std::string_view text = "");
 
         void draw() const override;
 
-        std::string content() const;
+        const std::string& content() const
+        {
+            return content_.str();
+        }
+
+        void set_content(std::string_view text);
 
-        void set_content(const std::string& text);
+        // content truncated to legacy_max_length
+        LegacyCode::Paragraph paragraph() const;
     };
 }
 
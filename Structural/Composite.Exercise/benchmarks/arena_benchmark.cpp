@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_arena_benchmark [shape_count] [heap|arena]
+//  - without a storage argument the drawing is generated and every storage
+//    mode is measured in a separate process (so RSS numbers do not interfere)
+
+namespace
+{
+    const string filename = "arena_benchmark.txt";
+
+    void generate_drawing(size_t shape_count)
+    {
+        GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+        Benchmark::ShapeGenerator generator;
+        for (size_t i = 0; i < shape_count; ++i)
+            doc.add(generator.next());
+
+        doc.save(filename);
+    }
+
+    void measure_storage(ShapeStorage storage, const string& name)
+    {
+        const size_t rss_before = Benchmark::resident_memory();
+
+        auto doc = make_unique<GraphicsDoc>(SingletonShapeTypeRegistry::instance(), storage);
+
+        auto load_time = Benchmark::measure([&] { doc->load(filename); });
+        const size_t rss_loaded = Benchmark::resident_memory();
+
+        unique_ptr<GraphicsDoc> copy;
+        auto copy_time = Benchmark::measure([&] { copy = make_unique<GraphicsDoc>(*doc); });
+
+        auto teardown_time = Benchmark::measure([&] {
+            copy.reset();
+            doc.reset();
+        });
+
+        cout << name << ":\tload: " << load_time << " s"
+             << "\tcopy: " << copy_time << " s"
+             << "\tteardown (2 docs): " << teardown_time << " s"
+             << "\tRSS after load: +" << (rss_loaded - rss_before) / (1024 * 1024) << " MiB" << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const string shape_count = argc > 1 ? argv[1] : "1000000";
+
+    if (argc > 2)
+    {
+        const string storage = argv[2];
+        measure_storage(storage == "arena" ? ShapeStorage::arena : ShapeStorage::heap, storage);
+        return 0;
+    }
+
+    cout << "Generating " << shape_count << " shapes..." << endl;
+    generate_drawing(stoul(shape_count));
+
+    int result = 0;
+    for (const char* storage : {"heap", "arena"})
+        result |= system((string("\"") + argv[0] + "\" " + shape_count + " " + storage).c_str());
+
+    remove(filename.c_str());
+
+    return result;
+}
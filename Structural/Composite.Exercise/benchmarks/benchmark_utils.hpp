@@ -0,0 +1,70 @@
+#ifndef BENCHMARK_UTILS_HPP
+#define BENCHMARK_UTILS_HPP
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "square.hpp"
+#include "text.hpp"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace Benchmark
+{
+    // wall time of a call in seconds
+    template <typename F>
+    double measure(F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // resident set size of the process in bytes (0 when not available)
+    inline std::size_t resident_memory()
+    {
+#ifdef __linux__
+        std::ifstream statm{"/proc/self/statm"};
+        std::size_t total_pages = 0, resident_pages = 0;
+        statm >> total_pages >> resident_pages;
+
+        return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    // deterministic mix of all shape types: Rectangle, Square, Circle, Text
+    class ShapeGenerator
+    {
+        std::mt19937 rnd_{42};
+        std::uniform_int_distribution<int> coord_{-10'000, 10'000};
+        std::uniform_int_distribution<int> size_{1, 500};
+        std::size_t count_ = 0;
+
+    public:
+        std::unique_ptr<Drawing::Shape> next()
+        {
+            switch (count_++ % 4)
+            {
+            case 0:
+                return std::make_unique<Drawing::Rectangle>(coord_(rnd_), coord_(rnd_), size_(rnd_), size_(rnd_));
+            case 1:
+                return std::make_unique<Drawing::Square>(coord_(rnd_), coord_(rnd_), size_(rnd_));
+            case 2:
+                return std::make_unique<Drawing::Circle>(coord_(rnd_), coord_(rnd_), size_(rnd_));
+            default:
+                return std::make_unique<Drawing::Text>(coord_(rnd_), coord_(rnd_), "Label" + std::to_string(count_ % 100));
+            }
+        }
+    };
+}
+
+#endif // BENCHMARK_UTILS_HPP
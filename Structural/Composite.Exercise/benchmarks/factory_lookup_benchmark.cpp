@@ -0,0 +1,61 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "shape_factories.hpp"
+#include "static_shape_factory.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_factory_lookup_benchmark [lookup_count]
+
+int main(int argc, char* argv[])
+{
+    const size_t lookup_count = argc > 1 ? stoul(argv[1]) : 10'000'000;
+
+    const vector<string_view> ids = {Rectangle::id, Square::id, Circle::id, Text::id};
+
+    mt19937 rnd{42};
+    uniform_int_distribution<size_t> pick{0, ids.size() - 1};
+
+    vector<string_view> id_views(lookup_count);
+    vector<string> id_strings(lookup_count);
+    for (size_t i = 0; i < lookup_count; ++i)
+    {
+        id_views[i] = ids[pick(rnd)];
+        id_strings[i] = string(id_views[i]);
+    }
+
+    size_t checksum = 0;
+
+    auto static_lookup_time = Benchmark::measure([&] {
+        for (auto id : id_views)
+            checksum += StaticShapeFactory::index_of(id);
+    });
+
+    auto static_create_time = Benchmark::measure([&] {
+        for (auto id : id_views)
+            checksum += StaticShapeFactory::create(id) != nullptr;
+    });
+
+    const auto& runtime_factory = SingletonShapeFactory::instance();
+
+    auto runtime_create_time = Benchmark::measure([&] {
+        for (const auto& id : id_strings)
+            checksum += runtime_factory.create(id) != nullptr;
+    });
+
+    auto report = [&](const char* name, double time) {
+        cout << name << ":\t" << time << " s\t(" << static_cast<size_t>(lookup_count / time) << " lookups/s)\n";
+    };
+
+    cout << "lookups: " << lookup_count << "\n";
+    report("StaticFactory::index_of", static_lookup_time);
+    report("StaticFactory::create", static_create_time);
+    report("GenericFactory::create", runtime_create_time);
+    cout << "(checksum " << checksum << ")" << endl;
+}
@@ -0,0 +1,177 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+#include "shape_group.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_group_benchmark [fanout] [depth] [nesting_depth]
+
+namespace
+{
+    // the textbook composite - members owned through pointers, every operation recurses
+    class PointerGroup : public CloneableShape<PointerGroup>
+    {
+        vector<unique_ptr<Shape>> members_;
+
+    public:
+        PointerGroup() = default;
+
+        PointerGroup(const PointerGroup& source)
+        {
+            for (const auto& member : source.members_)
+                members_.push_back(member->clone());
+        }
+
+        void add(unique_ptr<Shape> shp)
+        {
+            members_.push_back(std::move(shp));
+        }
+
+        void move(int dx, int dy) override
+        {
+            for (const auto& member : members_)
+                member->move(dx, dy);
+        }
+
+        void draw(RenderSink& sink) const override
+        {
+            for (const auto& member : members_)
+                member->draw(sink);
+        }
+
+        BoundingBox bounding_box() const override
+        {
+            BoundingBox result = members_.front()->bounding_box();
+            for (const auto& member : members_)
+                result = merge(result, member->bounding_box());
+
+            return result;
+        }
+    };
+
+    unique_ptr<PointerGroup> build_pointer_group(Benchmark::ShapeGenerator& generator, int fanout, int depth)
+    {
+        auto group = make_unique<PointerGroup>();
+
+        for (int i = 0; i < fanout; ++i)
+            group->add(depth > 1 ? build_pointer_group(generator, fanout, depth - 1) : generator.next());
+
+        return group;
+    }
+
+    void build_flat_group(ShapeGroup& group, Benchmark::ShapeGenerator& generator, int fanout, int depth)
+    {
+        for (int i = 0; i < fanout; ++i)
+        {
+            if (depth > 1)
+            {
+                group.begin_group();
+                build_flat_group(group, generator, fanout, depth - 1);
+                group.end_group();
+            }
+            else
+                group.add(generator.next());
+        }
+    }
+
+    string read_file(const string& filename)
+    {
+        ifstream file_in{filename, ios::binary};
+        return string{istreambuf_iterator<char>{file_in}, istreambuf_iterator<char>{}};
+    }
+
+    void report(const string& name, double pointer_time, double flat_time)
+    {
+        cout << name << ":\tpointer tree: " << pointer_time << " s\tflat nodes: " << flat_time << " s"
+             << "\tspeedup: " << pointer_time / flat_time << "\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int fanout = argc > 1 ? stoi(argv[1]) : 10;
+    const int depth = argc > 2 ? stoi(argv[2]) : 6;
+    const size_t nesting_depth = argc > 3 ? stoul(argv[3]) : 1'000'000;
+
+    Benchmark::ShapeGenerator pointer_generator, flat_generator;
+
+    auto pointer_group = build_pointer_group(pointer_generator, fanout, depth);
+
+    ShapeGroup flat_group;
+    build_flat_group(flat_group, flat_generator, fanout, depth);
+
+    cout << "group tree: fanout " << fanout << ", depth " << depth << ", nodes: " << flat_group.node_count() << "\n";
+
+    NullRenderSink pointer_sink, flat_sink;
+    report("draw", Benchmark::measure([&] { pointer_group->draw(pointer_sink); }),
+        Benchmark::measure([&] { flat_group.draw(flat_sink); }));
+
+    report("move", Benchmark::measure([&] { pointer_group->move(5, 5); }),
+        Benchmark::measure([&] { flat_group.move(5, 5); }));
+
+    BoundingBox pointer_box, flat_box;
+    report("bounds", Benchmark::measure([&] { pointer_box = pointer_group->bounding_box(); }),
+        Benchmark::measure([&] { flat_box = flat_group.bounding_box(); }));
+
+    // a member moves - only the groups on its path are recomputed
+    report("move member + bounds", Benchmark::measure([&] {
+        pointer_group->move(0, 0);
+        pointer_box = pointer_group->bounding_box();
+    }),
+        Benchmark::measure([&] {
+            flat_group.move_node(flat_group.node_count() - 1, 0, 0);
+            flat_box = flat_group.bounding_box();
+        }));
+
+    unique_ptr<Shape> pointer_copy, flat_copy;
+    report("clone", Benchmark::measure([&] { pointer_copy = pointer_group->clone(); }),
+        Benchmark::measure([&] { flat_copy = flat_group.clone(); }));
+
+    bool is_consistent = pointer_box == flat_box && pointer_sink.primitive_count() == flat_sink.primitive_count();
+
+    // deep nesting - would overflow the stack of a recursive reader
+    const string deep_filename = "group_benchmark_deep.txt";
+    const string saved_filename = "group_benchmark_saved.txt";
+    const string binary_filename = "group_benchmark.drwb";
+    {
+        ofstream out{deep_filename};
+        for (size_t i = 0; i < nesting_depth; ++i)
+            out << "ShapeGroup 1\n";
+        out << "Circle [10,20] 30\n";
+    }
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+    auto load_time = Benchmark::measure([&] { doc.load(deep_filename); });
+    cout << "nested " << nesting_depth << " levels deep:\tload: " << load_time << " s";
+
+    auto save_time = Benchmark::measure([&] { doc.save(saved_filename); });
+    cout << "\tsave: " << save_time << " s";
+
+    GraphicsDoc binary_doc{SingletonShapeTypeRegistry::instance()};
+    auto binary_time = Benchmark::measure([&] {
+        doc.save_binary(binary_filename);
+        binary_doc.load_binary(binary_filename);
+    });
+    cout << "\tbinary round trip: " << binary_time << " s\n";
+
+    binary_doc.save(binary_filename);
+    is_consistent = is_consistent && read_file(deep_filename) == read_file(saved_filename)
+        && read_file(deep_filename) == read_file(binary_filename);
+
+    cout << "results consistent: " << boolalpha << is_consistent << endl;
+
+    remove(deep_filename.c_str());
+    remove(saved_filename.c_str());
+    remove(binary_filename.c_str());
+
+    return is_consistent ? 0 : 1;
+}
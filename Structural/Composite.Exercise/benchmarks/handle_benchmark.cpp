@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_handle_benchmark [shape_count] [operation_count]
+
+namespace
+{
+    // a document without handles - shapes are found by address and shifted on every change
+    using ShapeList = vector<unique_ptr<Shape>>;
+
+    ShapeList::iterator find_shape(ShapeList& shapes, const Shape* shp)
+    {
+        return find_if(shapes.begin(), shapes.end(), [shp](const auto& item) { return item.get() == shp; });
+    }
+
+    void report(const string& name, double list_time, double doc_time)
+    {
+        cout << name << ":\tvector: " << list_time << " s\tslot map: " << doc_time << " s"
+             << "\tspeedup: " << list_time / doc_time << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t shape_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const size_t operation_count = argc > 2 ? stoul(argv[2]) : 100;
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+    ShapeList list;
+
+    Benchmark::ShapeGenerator generator;
+    for (size_t i = 0; i < shape_count; ++i)
+    {
+        auto shp = generator.next();
+        list.push_back(shp->clone());
+        doc.add(std::move(shp));
+    }
+
+    // distinct shapes to remove, bring to front & send to back
+    vector<size_t> positions(shape_count);
+    iota(positions.begin(), positions.end(), 0);
+    shuffle(positions.begin(), positions.end(), mt19937{7});
+    positions.resize(min(shape_count, 3 * operation_count));
+
+    vector<const Shape*> targets;
+    vector<ShapeHandle> handles;
+    for (auto position : positions)
+    {
+        targets.push_back(list[position].get());
+        handles.push_back(doc.handle(position));
+    }
+
+    const size_t removed_count = targets.size() / 3;
+    const size_t raised_count = targets.size() / 3;
+
+    cout << "shapes: " << shape_count << "\toperations: " << removed_count << " of each kind" << endl;
+
+    auto list_remove_time = Benchmark::measure([&] {
+        for (size_t i = 0; i < removed_count; ++i)
+            list.erase(find_shape(list, targets[i]));
+    });
+
+    auto doc_remove_time = Benchmark::measure([&] {
+        for (size_t i = 0; i < removed_count; ++i)
+            doc.remove(handles[i]);
+    });
+
+    report("remove", list_remove_time, doc_remove_time);
+
+    auto list_reorder_time = Benchmark::measure([&] {
+        for (size_t i = removed_count; i < removed_count + raised_count; ++i)
+        {
+            auto pos = find_shape(list, targets[i]);
+            rotate(pos, pos + 1, list.end());
+        }
+
+        for (size_t i = removed_count + raised_count; i < targets.size(); ++i)
+        {
+            auto pos = find_shape(list, targets[i]);
+            rotate(list.begin(), pos, pos + 1);
+        }
+    });
+
+    auto doc_reorder_time = Benchmark::measure([&] {
+        for (size_t i = removed_count; i < removed_count + raised_count; ++i)
+            doc.bring_to_front(handles[i]);
+
+        for (size_t i = removed_count + raised_count; i < targets.size(); ++i)
+            doc.send_to_back(handles[i]);
+    });
+
+    report("bring to front & send to back", list_reorder_time, doc_reorder_time);
+
+    // the first render restores the z-order of the dense storage
+    NullRenderSink null_sink;
+    auto first_render_time = Benchmark::measure([&] { doc.render(null_sink); });
+    auto render_time = Benchmark::measure([&] { doc.render(null_sink); });
+
+    cout << "render after changes: " << first_render_time << " s\trender: " << render_time << " s" << endl;
+
+    ostringstream list_out, doc_out;
+    {
+        TextRenderSink list_sink{list_out};
+        for (const auto& shp : list)
+            shp->draw(list_sink);
+        list_sink.flush();
+
+        TextRenderSink doc_sink{doc_out};
+        doc.render(doc_sink);
+    }
+
+    const bool is_consistent = doc.size() == list.size() && list_out.str() == doc_out.str()
+        && none_of(handles.begin(), handles.begin() + removed_count, [&](auto handle) { return doc.contains(handle); })
+        && all_of(handles.begin() + removed_count, handles.end(), [&](auto handle) { return doc.find(handle) != nullptr; });
+
+    cout << "results consistent: " << boolalpha << is_consistent << endl;
+
+    return is_consistent ? 0 : 1;
+}
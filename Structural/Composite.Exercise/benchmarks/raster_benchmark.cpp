@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+#include "rasterizer.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_raster_benchmark [dense_shape_count] [sparse_shape_count] [max_threads]
+
+namespace
+{
+    constexpr int frame_width = 1920;
+    constexpr int frame_height = 1080;
+
+    bool is_same_image(const Bitmap& a, const Bitmap& b)
+    {
+        for (int y = 0; y < a.height(); ++y)
+            if (!equal(a.row(y), a.row(y) + a.width(), b.row(y)))
+                return false;
+
+        return true;
+    }
+
+    bool run_scene(const string& name, size_t shape_count, unsigned int max_threads)
+    {
+        GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+        Benchmark::ShapeGenerator generator;
+        for (size_t i = 0; i < shape_count; ++i)
+            doc.add(generator.next());
+
+        // the generator spreads shapes over [-10'000, 10'000] - the frame shows its center
+        const Point origin{-frame_width / 2, -frame_height / 2};
+        const double frame_megapixels = frame_width * frame_height / 1e6;
+
+        Bitmap reference{frame_width, frame_height};
+        rasterize(doc, reference, origin, {}, 1);
+
+        cout << name << " scene: " << shape_count << " shapes, " << frame_width << "x" << frame_height << "\n";
+
+        bool is_consistent = true;
+
+        for (unsigned int thread_count = 1; thread_count <= max_threads; ++thread_count)
+        {
+            Bitmap frame{frame_width, frame_height};
+            size_t filled_pixels = 0;
+
+            auto elapsed = Benchmark::measure([&] { filled_pixels = rasterize(doc, frame, origin, {}, thread_count); });
+
+            cout << "  threads: " << thread_count
+                 << "\ttime: " << elapsed << " s"
+                 << "\tframe: " << frame_megapixels / elapsed << " MP/s"
+                 << "\tfill: " << filled_pixels / 1e6 / elapsed << " MP/s"
+                 << "\toverdraw: " << filled_pixels / (frame_megapixels * 1e6) << "\n";
+
+            is_consistent = is_consistent && is_same_image(reference, frame);
+        }
+
+        return is_consistent;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t dense_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const size_t sparse_count = argc > 2 ? stoul(argv[2]) : 10'000;
+    const unsigned int max_threads = argc > 3 ? stoul(argv[3]) : max(1u, thread::hardware_concurrency());
+
+    bool is_consistent = run_scene("dense", dense_count, max_threads);
+    is_consistent = run_scene("sparse", sparse_count, max_threads) && is_consistent;
+
+    cout << "images identical for all thread counts: " << boolalpha << is_consistent << endl;
+
+    return is_consistent ? 0 : 1;
+}
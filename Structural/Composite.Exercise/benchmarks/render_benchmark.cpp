@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_render_benchmark [shape_count]
+
+namespace
+{
+    // what every draw() did before sinks: formatted insertions and std::endl per shape
+    class EndlRenderSink : public RenderSink
+    {
+        ostream& out_;
+
+    public:
+        explicit EndlRenderSink(ostream& out)
+            : out_{out}
+        {
+        }
+
+        void draw_rectangle(const Point& coord, int width, int height) override
+        {
+            out_ << "Drawing rectangle at " << coord << " with width: " << width << " and height: " << height << endl;
+        }
+
+        void draw_circle(const Point& center, int radius) override
+        {
+            out_ << "Drawing a circle at " << center << " with radius " << radius << endl;
+        }
+
+        void draw_text(const Point& coord, string_view text) override
+        {
+            out_ << "Rendering text '" << text << "' at: [" << coord.x << ", " << coord.y << "]" << endl;
+        }
+    };
+
+    string read_file(const string& filename)
+    {
+        ifstream file_in{filename, ios::binary};
+        return string{istreambuf_iterator<char>{file_in}, istreambuf_iterator<char>{}};
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t shape_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+    Benchmark::ShapeGenerator generator;
+    for (size_t i = 0; i < shape_count; ++i)
+        doc.add(generator.next());
+
+    const string endl_filename = "render_benchmark_endl.txt";
+    const string buffered_filename = "render_benchmark_buffered.txt";
+
+    auto endl_time = Benchmark::measure([&] {
+        ofstream out{endl_filename};
+        EndlRenderSink sink{out};
+        doc.render(sink);
+    });
+
+    auto buffered_time = Benchmark::measure([&] {
+        ofstream out{buffered_filename};
+        TextRenderSink sink{out};
+        doc.render(sink);
+    });
+
+    NullRenderSink null_sink;
+    auto null_time = Benchmark::measure([&] { doc.render(null_sink); });
+
+    MemoryRenderSink memory_sink;
+    auto memory_time = Benchmark::measure([&] { doc.render(memory_sink); });
+
+    cout << "shapes: " << shape_count << "\n";
+    cout << "iostream + endl: " << endl_time << " s\n";
+    cout << "buffered text sink: " << buffered_time << " s\tspeedup: " << endl_time / buffered_time << "\n";
+    cout << "memory sink: " << memory_time << " s\n";
+    cout << "null sink (traversal only): " << null_time << " s\n";
+
+    const bool identical = read_file(endl_filename) == read_file(buffered_filename)
+        && null_sink.primitive_count() == shape_count && memory_sink.commands().size() == shape_count;
+    cout << "output identical: " << boolalpha << identical << endl;
+
+    remove(endl_filename.c_str());
+    remove(buffered_filename.c_str());
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+#include "shape_factories.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_save_benchmark [shape_count]
+
+namespace
+{
+    // GraphicsDoc::save before buffering: a reader-writer per shape, iostream formatting and std::endl
+    void save_with_streams(const vector<unique_ptr<Shape>>& shapes, const string& filename)
+    {
+        ofstream file_out{filename};
+
+        for (const auto& shp : shapes)
+        {
+            auto shape_rw = SingletonShapeRWFactory::instance().create(make_type_index(*shp));
+            shape_rw->write(*shp, file_out);
+        }
+    }
+
+    string read_file(const string& filename)
+    {
+        ifstream file_in{filename, ios::binary};
+        return string{istreambuf_iterator<char>{file_in}, istreambuf_iterator<char>{}};
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t shape_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+    vector<unique_ptr<Shape>> shapes;
+
+    Benchmark::ShapeGenerator generator;
+    for (size_t i = 0; i < shape_count; ++i)
+    {
+        auto shape = generator.next();
+        doc.add(shape->clone());
+        shapes.push_back(std::move(shape));
+    }
+
+    const string streams_filename = "save_benchmark_streams.txt";
+    const string buffered_filename = "save_benchmark_buffered.txt";
+
+    auto streams_time = Benchmark::measure([&] { save_with_streams(shapes, streams_filename); });
+    auto buffered_time = Benchmark::measure([&] { doc.save(buffered_filename); });
+
+    cout << "shapes: " << shape_count << "\n";
+    cout << "iostream + endl: " << streams_time << " s\t(" << static_cast<size_t>(shape_count / streams_time) << " shapes/s)\n";
+    cout << "buffered to_chars: " << buffered_time << " s\t(" << static_cast<size_t>(shape_count / buffered_time) << " shapes/s)\n";
+    cout << "speedup: " << streams_time / buffered_time << "\n";
+
+    const bool identical = read_file(streams_filename) == read_file(buffered_filename);
+    cout << "output identical: " << boolalpha << identical << endl;
+
+    remove(streams_filename.c_str());
+    remove(buffered_filename.c_str());
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+#include "shape_store.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_shape_store_benchmark [shape_count] [repetitions]
+
+namespace
+{
+    template <typename Renderable>
+    string render_to_string(Renderable& renderable)
+    {
+        ostringstream out;
+        TextRenderSink sink{out};
+        renderable.render(sink);
+
+        return out.str();
+    }
+
+    void report(const string& name, double doc_time, double store_time)
+    {
+        cout << name << ":\tGraphicsDoc: " << doc_time << " s\tShapeStore: " << store_time << " s"
+             << "\tspeedup: " << doc_time / store_time << "\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t shape_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const int repetitions = argc > 2 ? stoi(argv[2]) : 20;
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+    Benchmark::ShapeGenerator generator;
+    for (size_t i = 0; i < shape_count; ++i)
+        doc.add(generator.next());
+
+    ShapeStore store;
+    auto import_time = Benchmark::measure([&] { store = ShapeStore::import_from(doc); });
+
+    cout << "shapes: " << shape_count << "\n";
+    cout << "import: " << import_time << " s\n";
+
+    auto doc_translate_time = Benchmark::measure([&] {
+        for (int i = 0; i < repetitions; ++i)
+            for (const auto& shp : doc.shapes())
+                shp->move(1, -1);
+    });
+
+    auto store_translate_time = Benchmark::measure([&] {
+        for (int i = 0; i < repetitions; ++i)
+            store.translate_all(1, -1);
+    });
+
+    report("translate x" + to_string(repetitions), doc_translate_time, store_translate_time);
+
+    vector<BoundingBox> boxes;
+    auto boxes_time = Benchmark::measure([&] { boxes = store.bounding_boxes(); });
+    cout << "bounding boxes: " << boxes_time << " s\n";
+
+    string doc_output, store_output;
+    auto doc_render_time = Benchmark::measure([&] { doc_output = render_to_string(doc); });
+    auto store_render_time = Benchmark::measure([&] { store_output = render_to_string(store); });
+
+    report("render", doc_render_time, store_render_time);
+
+    GraphicsDoc exported{SingletonShapeTypeRegistry::instance()};
+    auto export_time = Benchmark::measure([&] { store.export_to(exported); });
+    cout << "export: " << export_time << " s\n";
+
+    const bool identical = doc_output == store_output && render_to_string(exported) == doc_output;
+    cout << "output identical: " << boolalpha << identical << endl;
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_spatial_index_benchmark [shape_count] [query_count]
+
+namespace
+{
+    // what the viewer had to do without an index
+    vector<size_t> linear_query(const GraphicsDoc& doc, const BoundingBox& area)
+    {
+        vector<size_t> result;
+        for (size_t i = 0; i < doc.shapes().size(); ++i)
+            if (intersects(doc.shapes()[i]->bounding_box(), area))
+                result.push_back(i);
+
+        return result;
+    }
+
+    optional<size_t> linear_pick(const GraphicsDoc& doc, const Point& pt)
+    {
+        for (size_t i = doc.shapes().size(); i-- > 0;)
+            if (contains(doc.shapes()[i]->bounding_box(), pt))
+                return i;
+
+        return nullopt;
+    }
+
+    void report(const string& name, double linear_time, double indexed_time)
+    {
+        cout << name << ":\tlinear: " << linear_time << " s\tindexed: " << indexed_time << " s"
+             << "\tspeedup: " << linear_time / indexed_time << "\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t shape_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const size_t query_count = argc > 2 ? stoul(argv[2]) : 100;
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+    Benchmark::ShapeGenerator generator;
+    auto build_time = Benchmark::measure([&] {
+        for (size_t i = 0; i < shape_count; ++i)
+            doc.add(generator.next());
+    });
+
+    cout << "shapes: " << shape_count << "\tadd (with indexing): " << build_time << " s\n";
+
+    // viewports of 1000x800 and cursor positions within the generated area
+    mt19937 rnd{7};
+    uniform_int_distribution<int> coord{-10'000, 10'000};
+
+    vector<BoundingBox> viewports;
+    vector<Point> cursors;
+    for (size_t i = 0; i < query_count; ++i)
+    {
+        const int x = coord(rnd), y = coord(rnd);
+        viewports.push_back({x, y, x + 1000, y + 800});
+        cursors.push_back({coord(rnd), coord(rnd)});
+    }
+
+    size_t linear_found = 0, indexed_found = 0;
+
+    auto linear_query_time = Benchmark::measure([&] {
+        for (const auto& viewport : viewports)
+            linear_found += linear_query(doc, viewport).size();
+    });
+
+    auto indexed_query_time = Benchmark::measure([&] {
+        for (const auto& viewport : viewports)
+            indexed_found += doc.query(viewport).size();
+    });
+
+    report("query x" + to_string(query_count), linear_query_time, indexed_query_time);
+
+    bool is_consistent = linear_found == indexed_found;
+
+    vector<optional<size_t>> linear_picks, indexed_picks;
+
+    auto linear_pick_time = Benchmark::measure([&] {
+        for (const auto& cursor : cursors)
+            linear_picks.push_back(linear_pick(doc, cursor));
+    });
+
+    auto indexed_pick_time = Benchmark::measure([&] {
+        for (const auto& cursor : cursors)
+            indexed_picks.push_back(doc.pick(cursor));
+    });
+
+    report("pick x" + to_string(query_count), linear_pick_time, indexed_pick_time);
+
+    is_consistent = is_consistent && linear_picks == indexed_picks;
+
+    // move every shape once - most stay within their grid cells
+    auto move_time = Benchmark::measure([&] {
+        for (size_t i = 0; i < shape_count; ++i)
+            doc.move(i, 3, -2);
+    });
+
+    cout << "move all (with re-indexing): " << move_time << " s\n";
+
+    is_consistent = is_consistent && linear_query(doc, viewports.front()) == doc.query(viewports.front());
+
+    ostringstream out;
+    TextRenderSink sink{out};
+    auto render_time = Benchmark::measure([&] { doc.render(sink); });
+    out.str("");
+    auto render_region_time = Benchmark::measure([&] { doc.render_region(viewports.front(), sink); });
+
+    report("render viewport", render_time, render_region_time);
+
+    cout << "results consistent: " << boolalpha << is_consistent << endl;
+
+    return is_consistent ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+#include "shape_group.hpp"
+#include "shape_readers_writers/drawing_stream.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_stream_benchmark [shape_count] [load|stream text|binary]
+//  - without a mode all modes are measured, each in a separate process (so RSS numbers do not interfere)
+
+namespace
+{
+    const string text_filename = "stream_benchmark.txt";
+    const string binary_filename = "stream_benchmark.bin";
+    const string converted_filename = "stream_benchmark_converted.txt";
+
+    // aggregate computed over a drawing - the same for both ways of reading it
+    struct Statistics
+    {
+        size_t shape_count = 0; // groups included
+        long long extent = 0;   // sum of bounding box widths & heights
+
+        void add(const BoundingBox& box)
+        {
+            ++shape_count;
+            extent += (box.right - box.left) + (box.bottom - box.top);
+        }
+    };
+
+    class StatisticsVisitor : public IO::DrawingVisitor
+    {
+        Statistics& stats_;
+
+    public:
+        explicit StatisticsVisitor(Statistics& stats)
+            : stats_{stats}
+        {
+        }
+
+        void on_rectangle(const Point& coord, int width, int height) override
+        {
+            stats_.add(Rectangle{coord.x, coord.y, width, height}.bounding_box());
+        }
+
+        void on_square(const Point& coord, int size) override
+        {
+            stats_.add(Square{coord.x, coord.y, size}.bounding_box());
+        }
+
+        void on_circle(const Point& center, int radius) override
+        {
+            stats_.add(Circle{center.x, center.y, radius}.bounding_box());
+        }
+
+        void on_text(const Point& coord, string_view text) override
+        {
+            const int width = static_cast<int>(text.size()) * Text::glyph_width;
+            stats_.add(BoundingBox{coord.x, coord.y, coord.x + width, coord.y + Text::glyph_height});
+        }
+
+        void on_group_begin(int) override
+        {
+            ++stats_.shape_count;
+        }
+    };
+
+    Statistics statistics_of(const GraphicsDoc& doc)
+    {
+        Statistics stats;
+
+        for (const auto& shp : doc.shapes())
+        {
+            if (const auto* group = dynamic_cast<const ShapeGroup*>(shp.get()))
+            {
+                ++stats.shape_count;
+
+                for (size_t node = 0; node < group->node_count(); ++node)
+                {
+                    if (group->is_group(node))
+                        ++stats.shape_count;
+                    else
+                        stats.add(group->shape(node).bounding_box());
+                }
+            }
+            else
+                stats.add(shp->bounding_box());
+        }
+
+        return stats;
+    }
+
+    // every 10th shape is a group of 8 shapes with a nested group of 4
+    void generate_drawing(size_t shape_count)
+    {
+        Benchmark::ShapeGenerator generator;
+        GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+        for (size_t i = 0; i < shape_count; ++i)
+        {
+            if (i % 10 == 9)
+            {
+                auto group = make_unique<ShapeGroup>();
+                for (int m = 0; m < 4; ++m)
+                    group->add(generator.next());
+
+                group->begin_group();
+                for (int m = 0; m < 4; ++m)
+                    group->add(generator.next());
+                group->end_group();
+
+                doc.add(std::move(group));
+            }
+            else
+                doc.add(generator.next());
+        }
+
+        doc.save(text_filename);
+        doc.save_binary(binary_filename);
+    }
+
+    string read_file(const string& filename)
+    {
+        ifstream file_in{filename, ios::binary};
+        return string{istreambuf_iterator<char>{file_in}, istreambuf_iterator<char>{}};
+    }
+
+    void run(const string& mode, const string& format)
+    {
+        const size_t rss_before = Benchmark::resident_memory();
+        Statistics stats;
+
+        auto elapsed = Benchmark::measure([&] {
+            if (mode == "load")
+            {
+                GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+                format == "text" ? doc.load(text_filename) : doc.load_binary(binary_filename);
+
+                stats = statistics_of(doc);
+                cout << mode << " " << format << ":\tmemory: " << (Benchmark::resident_memory() - rss_before) / 1024 << " KiB";
+            }
+            else
+            {
+                StatisticsVisitor visitor{stats};
+                format == "text" ? IO::stream_text(text_filename, visitor) : IO::stream_binary(binary_filename, visitor);
+
+                cout << mode << " " << format << ":\tmemory: " << (Benchmark::resident_memory() - rss_before) / 1024 << " KiB";
+            }
+        });
+
+        cout << "\ttime: " << elapsed << " s"
+             << "\tshapes: " << stats.shape_count << "\textent: " << stats.extent << endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const string shape_count = argc > 1 ? argv[1] : "1000000";
+
+    if (argc > 3)
+    {
+        run(argv[2], argv[3]);
+        return 0;
+    }
+
+    cout << "Generating " << shape_count << " shapes..." << endl;
+    generate_drawing(stoul(shape_count));
+
+    int result = 0;
+    for (const char* format : {"text", "binary"})
+        for (const char* mode : {"load", "stream"})
+            result |= system((string("\"") + argv[0] + "\" " + shape_count + " " + mode + " " + format).c_str());
+
+    // constant-memory conversion gives the same file as loading & saving the document
+    auto convert_time = Benchmark::measure([] {
+        ofstream file_out{converted_filename, ios::binary};
+        IO::TextDrawingWriter writer{file_out};
+        IO::stream_binary(binary_filename, writer);
+    });
+
+    cout << "binary -> text streamed:\t" << convert_time << " s" << endl;
+
+    if (read_file(converted_filename) != read_file(text_filename))
+    {
+        cerr << "Streamed conversion differs from the saved document" << endl;
+        result = 1;
+    }
+
+    remove(text_filename.c_str());
+    remove(binary_filename.c_str());
+    remove(converted_filename.c_str());
+
+    return result;
+}
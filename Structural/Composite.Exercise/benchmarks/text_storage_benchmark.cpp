@@ -0,0 +1,140 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "render_sink.hpp"
+#include "text.hpp"
+#include "text_pool.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_text_storage_benchmark [text_count] [distinct_labels]
+
+namespace
+{
+    atomic<size_t> allocated_bytes{0};
+}
+
+void* operator new(size_t size)
+{
+    allocated_bytes += size;
+
+    if (void* ptr = malloc(size ? size : 1))
+        return ptr;
+
+    throw bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+namespace
+{
+    // Text before interning - a class adapter owning a LegacyCode::Paragraph (1 KiB buffer)
+    class ParagraphText : public ShapeBase<ParagraphText>, private LegacyCode::Paragraph
+    {
+    public:
+        ParagraphText(int x, int y, const string& text)
+            : ShapeBase{x, y}, LegacyCode::Paragraph{text.c_str()}
+        {
+        }
+
+        void draw(RenderSink& sink) const override
+        {
+            sink.draw_text(coord(), get_paragraph());
+        }
+
+        BoundingBox bounding_box() const override
+        {
+            return {coord().x, coord().y, coord().x, coord().y};
+        }
+    };
+
+    template <typename TextType>
+    void measure_storage(const string& name, size_t text_count, size_t distinct_labels)
+    {
+        vector<unique_ptr<Shape>> texts;
+        texts.reserve(text_count);
+
+        const size_t bytes_before = allocated_bytes;
+
+        auto create_time = Benchmark::measure([&] {
+            for (size_t i = 0; i < text_count; ++i)
+                texts.push_back(make_unique<TextType>(static_cast<int>(i), 0, "Label" + to_string(i % distinct_labels)));
+        });
+
+        const size_t bytes_used = allocated_bytes - bytes_before;
+
+        vector<unique_ptr<Shape>> copies;
+        copies.reserve(text_count);
+
+        auto clone_time = Benchmark::measure([&] {
+            for (const auto& text : texts)
+                copies.push_back(text->clone());
+        });
+
+        cout << name << ":\tsizeof: " << sizeof(TextType) << " B"
+             << "\theap per Text: " << static_cast<double>(bytes_used) / text_count << " B"
+             << "\tcreate: " << create_time << " s\tclone: " << clone_time << " s\n";
+    }
+
+    // Drawing a Text never needs a Paragraph - a Paragraph materialized in every draw() moves its
+    // 1 KiB allocation from construction into each frame. Adapter.Exercise's Text::draw pays that
+    // per frame to render through its adaptee; here paragraph() is only for legacy callers.
+    void measure_draw(size_t text_count, size_t distinct_labels)
+    {
+        vector<Text> texts;
+        texts.reserve(text_count);
+        for (size_t i = 0; i < text_count; ++i)
+            texts.emplace_back(static_cast<int>(i), 0, "Label" + to_string(i % distinct_labels));
+
+        NullRenderSink sink;
+
+        const size_t bytes_before_draw = allocated_bytes;
+        auto draw_time = Benchmark::measure([&] {
+            for (const auto& text : texts)
+                text.draw(sink);
+        });
+        const size_t bytes_per_draw = (allocated_bytes - bytes_before_draw) / text_count;
+
+        const size_t bytes_before_paragraph = allocated_bytes;
+        auto paragraph_time = Benchmark::measure([&] {
+            for (const auto& text : texts)
+                sink.draw_text(text.coord(), text.paragraph().get_paragraph());
+        });
+        const size_t bytes_per_paragraph = (allocated_bytes - bytes_before_paragraph) / text_count;
+
+        cout << "draw():\t\t\t\theap per frame: " << bytes_per_draw << " B\ttime: " << draw_time << " s\n"
+             << "Paragraph per frame:\t\theap per frame: " << bytes_per_paragraph << " B\ttime: " << paragraph_time << " s\n";
+
+        cout << "text pool: " << TextPool::instance().size() << " labels, " << TextPool::instance().memory_usage() << " B\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t text_count = argc > 1 ? stoul(argv[1]) : 1'000'000;
+    const size_t distinct_labels = argc > 2 ? stoul(argv[2]) : 1'000;
+
+    cout << "texts: " << text_count << "\tdistinct labels: " << distinct_labels << "\n";
+
+    measure_storage<ParagraphText>("LegacyCode::Paragraph", text_count, distinct_labels);
+    measure_storage<Text>("interned", text_count, distinct_labels);
+
+    measure_draw(text_count, distinct_labels);
+
+    cout << "text pool after all texts are destroyed: " << TextPool::instance().size() << " labels" << endl;
+}
@@ -0,0 +1,167 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "graphics_doc.hpp"
+#include "variant_doc.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+// usage: Composite.Exercise_variant_benchmark [shape_count] [virtual|variant]
+//  - without a design both are measured, each in a separate process (so RSS numbers do not interfere)
+
+namespace
+{
+    const string text_filename = "variant_benchmark.txt";
+    const string binary_filename = "variant_benchmark.bin";
+    const string saved_filename = "variant_benchmark_saved.txt";
+
+    constexpr int pass_count = 10;
+
+    long long extent_of(const BoundingBox& box)
+    {
+        return (box.right - box.left) + (box.bottom - box.top);
+    }
+
+    // the same operations for both designs
+    struct VirtualDesign
+    {
+        using Document = GraphicsDoc;
+
+        static void render(Document& doc, RenderSink& sink)
+        {
+            doc.render(sink);
+        }
+
+        static void move_all(Document& doc)
+        {
+            for (const auto& shp : doc.shapes())
+                shp->move(1, -1);
+        }
+
+        static long long total_extent(const Document& doc)
+        {
+            long long extent = 0;
+            for (const auto& shp : doc.shapes())
+                extent += extent_of(shp->bounding_box());
+
+            return extent;
+        }
+    };
+
+    struct VariantDesign
+    {
+        using Document = VariantDoc;
+
+        static void render(Document& doc, RenderSink& sink)
+        {
+            doc.render(sink);
+        }
+
+        static void move_all(Document& doc)
+        {
+            for (size_t i = 0; i < doc.size(); ++i)
+                doc.move(i, 1, -1);
+        }
+
+        static long long total_extent(const Document& doc)
+        {
+            long long extent = 0;
+            for (const auto& shp : doc.shapes())
+                extent += extent_of(bounding_box(shp));
+
+            return extent;
+        }
+    };
+
+    template <typename Design>
+    void run(const string& name)
+    {
+        const auto rss_before = Benchmark::resident_memory();
+
+        typename Design::Document doc{SingletonShapeTypeRegistry::instance()};
+        auto load_time = Benchmark::measure([&] { doc.load(text_filename); });
+
+        const auto memory = Benchmark::resident_memory() - rss_before;
+
+        auto load_binary_time = Benchmark::measure([] {
+            typename Design::Document binary_doc{SingletonShapeTypeRegistry::instance()};
+            binary_doc.load_binary(binary_filename);
+        });
+
+        NullRenderSink sink;
+        auto render_time = Benchmark::measure([&] {
+            for (int i = 0; i < pass_count; ++i)
+                Design::render(doc, sink);
+        });
+
+        auto move_time = Benchmark::measure([&] {
+            for (int i = 0; i < pass_count; ++i)
+                Design::move_all(doc);
+        });
+
+        long long extent = 0;
+        auto extent_time = Benchmark::measure([&] {
+            for (int i = 0; i < pass_count; ++i)
+                extent += Design::total_extent(doc);
+        });
+
+        cout << name << ":\tload: " << load_time << " s\tload binary: " << load_binary_time << " s"
+             << "\tmemory: " << memory / doc.size() << " B/shape"
+             << "\trender: " << render_time / pass_count << " s\tmove: " << move_time / pass_count << " s"
+             << "\tbounding boxes: " << extent_time / pass_count << " s\t(extent " << extent << ", "
+             << sink.primitive_count() << " primitives)" << endl;
+    }
+
+    string read_file(const string& filename)
+    {
+        ifstream file_in{filename, ios::binary};
+        return string{istreambuf_iterator<char>{file_in}, istreambuf_iterator<char>{}};
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const string shape_count = argc > 1 ? argv[1] : "1000000";
+
+    if (argc > 2)
+    {
+        string{argv[2]} == "virtual" ? run<VirtualDesign>(argv[2]) : run<VariantDesign>(argv[2]);
+        return 0;
+    }
+
+    {
+        GraphicsDoc doc{SingletonShapeTypeRegistry::instance()};
+
+        Benchmark::ShapeGenerator generator;
+        for (size_t i = 0; i < stoul(shape_count); ++i)
+            doc.add(generator.next());
+
+        doc.save(text_filename);
+        doc.save_binary(binary_filename);
+    }
+
+    cout << "shapes: " << shape_count << "\tsizeof(ShapeVariant): " << sizeof(ShapeVariant) << " B" << endl;
+
+    int result = 0;
+    for (const char* design : {"virtual", "variant"})
+        result |= system((string("\"") + argv[0] + "\" " + shape_count + " " + design).c_str());
+
+    // files are interchangeable between the designs
+    VariantDoc variant_doc{SingletonShapeTypeRegistry::instance()};
+    variant_doc.load_binary(binary_filename);
+    variant_doc.save(saved_filename);
+
+    const bool is_interchangeable = read_file(saved_filename) == read_file(text_filename);
+    cout << "files interchangeable: " << boolalpha << is_interchangeable << endl;
+
+    remove(text_filename.c_str());
+    remove(binary_filename.c_str());
+    remove(saved_filename.c_str());
+
+    return is_interchangeable ? result : 1;
+}
@@ -0,0 +1,85 @@
+#include "bitmap.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace Drawing;
+
+struct Bitmap::BitmapImpl
+{
+    int width_;
+    int height_;
+    std::vector<Color> pixels_;
+};
+
+Bitmap::Bitmap(int width, int height, Color background)
+{
+    if (width <= 0 || height <= 0)
+        throw invalid_argument("Bitmap: width and height must be positive");
+
+    pimpl_ = make_unique<BitmapImpl>(BitmapImpl{width, height, vector<Color>(static_cast<size_t>(width) * height, background)});
+}
+
+Bitmap::~Bitmap() = default;
+
+Bitmap::Bitmap(Bitmap&&) noexcept = default;
+
+Bitmap& Bitmap::operator=(Bitmap&&) noexcept = default;
+
+int Bitmap::width() const
+{
+    return pimpl_->width_;
+}
+
+int Bitmap::height() const
+{
+    return pimpl_->height_;
+}
+
+Color* Bitmap::row(int y)
+{
+    return pimpl_->pixels_.data() + static_cast<size_t>(y) * pimpl_->width_;
+}
+
+const Color* Bitmap::row(int y) const
+{
+    return pimpl_->pixels_.data() + static_cast<size_t>(y) * pimpl_->width_;
+}
+
+Color Bitmap::pixel(int x, int y) const
+{
+    if (x < 0 || x >= width() || y < 0 || y >= height())
+        throw out_of_range("Bitmap: pixel out of range");
+
+    return row(y)[x];
+}
+
+void Bitmap::clear(Color background)
+{
+    fill(pimpl_->pixels_.begin(), pimpl_->pixels_.end(), background);
+}
+
+void Bitmap::write_ppm(ostream& out) const
+{
+    out << "P6\n"
+        << width() << ' ' << height() << "\n255\n";
+
+    vector<char> rgb_row(static_cast<size_t>(width()) * 3);
+
+    for (int y = 0; y < height(); ++y)
+    {
+        const Color* pixels = row(y);
+
+        for (int x = 0; x < width(); ++x)
+        {
+            rgb_row[3 * x] = static_cast<char>((pixels[x] >> 16) & 0xFF);
+            rgb_row[3 * x + 1] = static_cast<char>((pixels[x] >> 8) & 0xFF);
+            rgb_row[3 * x + 2] = static_cast<char>(pixels[x] & 0xFF);
+        }
+
+        out.write(rgb_row.data(), rgb_row.size());
+    }
+}
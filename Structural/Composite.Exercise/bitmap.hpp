@@ -0,0 +1,45 @@
+#ifndef BITMAP_HPP
+#define BITMAP_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+namespace Drawing
+{
+    using Color = std::uint32_t; // 0x00RRGGBB
+
+    // Framebuffer of width x height pixels stored row by row in one contiguous block
+    // (pimpl as in Structural/Bridge.Pimpl)
+    class Bitmap
+    {
+        struct BitmapImpl;
+        std::unique_ptr<BitmapImpl> pimpl_;
+
+    public:
+        Bitmap(int width, int height, Color background = 0xFFFFFF);
+        ~Bitmap();
+
+        Bitmap(const Bitmap&) = delete;
+        Bitmap& operator=(const Bitmap&) = delete;
+
+        Bitmap(Bitmap&&) noexcept;
+        Bitmap& operator=(Bitmap&&) noexcept;
+
+        int width() const;
+        int height() const;
+
+        // first pixel of a row - rows are width() pixels long
+        Color* row(int y);
+        const Color* row(int y) const;
+
+        Color pixel(int x, int y) const;
+
+        void clear(Color background);
+
+        // binary PPM (P6) - viewable by most image tools
+        void write_ppm(std::ostream& out) const;
+    };
+}
+
+#endif // BITMAP_HPP
@@ -0,0 +1,101 @@
+#ifndef BITMAP_FONT_HPP
+#define BITMAP_FONT_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace Drawing
+{
+    namespace Font
+    {
+        // 5x7 glyphs - a row per byte, bit 4 is the leftmost column
+        constexpr int glyph_columns = 5;
+        constexpr int glyph_rows = 7;
+
+        using Glyph = std::array<std::uint8_t, glyph_rows>;
+
+        namespace Details
+        {
+            constexpr std::array<Glyph, 10> digits = {{
+                {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // 0
+                {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 1
+                {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // 2
+                {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // 3
+                {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // 4
+                {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // 5
+                {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // 6
+                {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // 7
+                {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // 8
+                {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // 9
+            }};
+
+            constexpr std::array<Glyph, 26> letters = {{
+                {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}, // A
+                {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // B
+                {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // C
+                {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // D
+                {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // E
+                {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // F
+                {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // G
+                {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // H
+                {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // I
+                {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // J
+                {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // K
+                {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // L
+                {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // M
+                {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // N
+                {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // O
+                {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // P
+                {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // Q
+                {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // R
+                {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // S
+                {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // T
+                {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // U
+                {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // V
+                {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // W
+                {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // X
+                {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // Y
+                {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // Z
+            }};
+
+            constexpr Glyph space = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+            constexpr Glyph period = {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C};
+            constexpr Glyph comma = {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08};
+            constexpr Glyph hyphen = {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00};
+            constexpr Glyph exclamation = {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04};
+            constexpr Glyph question = {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04};
+            constexpr Glyph unknown = {0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F};
+        }
+
+        // lowercase letters are drawn with the uppercase glyphs
+        constexpr const Glyph& glyph(char c)
+        {
+            if (c >= '0' && c <= '9')
+                return Details::digits[c - '0'];
+            if (c >= 'A' && c <= 'Z')
+                return Details::letters[c - 'A'];
+            if (c >= 'a' && c <= 'z')
+                return Details::letters[c - 'a'];
+
+            switch (c)
+            {
+            case ' ':
+                return Details::space;
+            case '.':
+                return Details::period;
+            case ',':
+                return Details::comma;
+            case '-':
+                return Details::hyphen;
+            case '!':
+                return Details::exclamation;
+            case '?':
+                return Details::question;
+            default:
+                return Details::unknown;
+            }
+        }
+    }
+}
+
+#endif // BITMAP_FONT_HPP
@@ -0,0 +1,50 @@
+#ifndef BOUNDING_BOX_HPP
+#define BOUNDING_BOX_HPP
+
+#include "point.hpp"
+
+namespace Drawing
+{
+    // axis-aligned box in drawing coordinates (right & bottom are inclusive)
+    struct BoundingBox
+    {
+        int left = 0;
+        int top = 0;
+        int right = 0;
+        int bottom = 0;
+    };
+
+    inline bool operator==(const BoundingBox& a, const BoundingBox& b)
+    {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    inline bool operator!=(const BoundingBox& a, const BoundingBox& b)
+    {
+        return !(a == b);
+    }
+
+    inline bool intersects(const BoundingBox& a, const BoundingBox& b)
+    {
+        return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+    }
+
+    inline bool contains(const BoundingBox& box, const Point& pt)
+    {
+        return box.left <= pt.x && pt.x <= box.right && box.top <= pt.y && pt.y <= box.bottom;
+    }
+
+    // smallest box covering both boxes
+    inline BoundingBox merge(const BoundingBox& a, const BoundingBox& b)
+    {
+        return {a.left < b.left ? a.left : b.left, a.top < b.top ? a.top : b.top,
+            a.right > b.right ? a.right : b.right, a.bottom > b.bottom ? a.bottom : b.bottom};
+    }
+
+    inline BoundingBox translated(const BoundingBox& box, int dx, int dy)
+    {
+        return {box.left + dx, box.top + dy, box.right + dx, box.bottom + dy};
+    }
+}
+
+#endif // BOUNDING_BOX_HPP
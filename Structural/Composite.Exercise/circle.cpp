@@ -25,7 +25,12 @@ void Circle::set_radius(int radius)
     radius_ = radius;
 }
 
-void Circle::draw() const
+BoundingBox Circle::bounding_box() const
 {
-    cout << "Drawing a circle at " << coord() << " with radius " << radius() << endl;
+    return {coord().x - radius_, coord().y - radius_, coord().x + radius_, coord().y + radius_};
+}
+
+void Circle::draw(RenderSink& sink) const
+{
+    sink.draw_circle(coord(), radius_);
 }
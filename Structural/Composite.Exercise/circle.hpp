@@ -18,7 +18,9 @@ namespace Drawing
 
         void set_radius(int radius);
 
-        void draw() const override;
+        void draw(RenderSink& sink) const override;
+
+        BoundingBox bounding_box() const override;
     };
 }
 
@@ -0,0 +1,380 @@
+#include "graphics_doc.hpp"
+#include "mapped_file.hpp"
+#include "shape_readers_writers/scanner.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace std;
+using namespace Drawing;
+using namespace Drawing::IO;
+
+namespace
+{
+    constexpr size_t arena_initial_size = 64 * 1024;
+}
+
+GraphicsDoc::GraphicsDoc(const ShapeTypeRegistry& shape_types, ShapeStorage storage)
+    : shape_types_{shape_types}
+{
+    if (storage == ShapeStorage::arena)
+        arena_ = make_unique<Arena>(arena_initial_size);
+}
+
+GraphicsDoc::GraphicsDoc(const GraphicsDoc& source)
+    : GraphicsDoc{source.shape_types_, source.arena_ ? ShapeStorage::arena : ShapeStorage::heap}
+{
+    shapes_.reserve(source.shapes_.size());
+
+    for (const auto& shp : source.shapes_)
+        shapes_.push_back(shp->clone(memory_resource()));
+
+    // the same slots - handles to shapes of the source refer to their copies
+    slot_of_ = source.slot_of_;
+    depth_of_ = source.depth_of_;
+    slots_ = source.slots_;
+    free_slots_ = source.free_slots_;
+    top_depth_ = source.top_depth_;
+    bottom_depth_ = source.bottom_depth_;
+    is_in_z_order_ = source.is_in_z_order_;
+    index_ = source.index_;
+}
+
+// a shape leaves the index while it is empty and returns when it gets its first leaf
+void GraphicsDoc::reindex(uint32_t slot, const Shape& shp)
+{
+    if (shp.is_empty())
+    {
+        if (index_.contains(slot))
+            index_.remove(slot);
+    }
+    else if (index_.contains(slot))
+        index_.update(slot, shp.bounding_box());
+    else
+        index_.insert(slot, shp.bounding_box());
+}
+
+ShapeHandle GraphicsDoc::add(ShapePtr shp)
+{
+    if (shapes_.size() >= no_slot)
+        throw length_error("GraphicsDoc: too many shapes");
+
+    const auto box = shp->bounding_box();
+    const bool is_indexed = !shp->is_empty(); // an empty group has no bounds to query
+    const auto position = shapes_.size();
+    const bool is_new_slot = free_slots_ == no_slot;
+    const auto slot = is_new_slot ? static_cast<uint32_t>(slots_.size()) : free_slots_;
+
+    if (is_new_slot)
+        slots_.push_back(Slot{0, no_slot});
+
+    try
+    {
+        shapes_.push_back(std::move(shp));
+        slot_of_.push_back(slot);
+        depth_of_.push_back(top_depth_ + 1);
+        if (is_indexed)
+            index_.insert(slot, box);
+    }
+    catch (...)
+    {
+        shapes_.resize(min(shapes_.size(), position));
+        slot_of_.resize(min(slot_of_.size(), position));
+        depth_of_.resize(min(depth_of_.size(), position));
+
+        if (is_new_slot)
+            slots_.pop_back();
+
+        throw;
+    }
+
+    if (!is_new_slot)
+        free_slots_ = slots_[slot].position;
+
+    slots_[slot].position = static_cast<uint32_t>(position);
+    ++top_depth_;
+
+    return {slot, slots_[slot].generation};
+}
+
+bool GraphicsDoc::remove(ShapeHandle handle)
+{
+    if (!contains(handle))
+        return false;
+
+    const auto position = slots_[handle.slot].position;
+    const auto last = shapes_.size() - 1;
+
+    if (index_.contains(handle.slot))
+        index_.remove(handle.slot);
+
+    // the last shape fills the hole
+    if (position != last)
+    {
+        shapes_[position] = std::move(shapes_[last]);
+        slot_of_[position] = slot_of_[last];
+        depth_of_[position] = depth_of_[last];
+        slots_[slot_of_[position]].position = position;
+        is_in_z_order_ = false;
+    }
+
+    shapes_.pop_back();
+    slot_of_.pop_back();
+    depth_of_.pop_back();
+
+    Slot& slot = slots_[handle.slot];
+    ++slot.generation; // invalidates all handles to the slot
+    slot.position = free_slots_;
+    free_slots_ = handle.slot;
+
+    return true;
+}
+
+bool GraphicsDoc::contains(ShapeHandle handle) const
+{
+    if (handle.slot >= slots_.size() || slots_[handle.slot].generation != handle.generation)
+        return false;
+
+    // a free slot links to the next free slot
+    const auto position = slots_[handle.slot].position;
+
+    return position < slot_of_.size() && slot_of_[position] == handle.slot;
+}
+
+size_t GraphicsDoc::position_of(ShapeHandle handle) const
+{
+    if (!contains(handle))
+        throw out_of_range("GraphicsDoc: stale shape handle");
+
+    return slots_[handle.slot].position;
+}
+
+Shape* GraphicsDoc::find(ShapeHandle handle) const
+{
+    return contains(handle) ? shapes_[slots_[handle.slot].position].get() : nullptr;
+}
+
+void GraphicsDoc::move(size_t position, int dx, int dy)
+{
+    auto& shp = *shapes_.at(position);
+
+    shp.move(dx, dy);
+    reindex(slot_of_[position], shp);
+}
+
+void GraphicsDoc::move(ShapeHandle handle, int dx, int dy)
+{
+    move(position_of(handle), dx, dy);
+}
+
+void GraphicsDoc::refresh(size_t position)
+{
+    reindex(slot_of_.at(position), *shapes_.at(position));
+}
+
+void GraphicsDoc::refresh(ShapeHandle handle)
+{
+    refresh(position_of(handle));
+}
+
+void GraphicsDoc::bring_to_front(ShapeHandle handle)
+{
+    const auto position = position_of(handle);
+
+    if (depth_of_[position] == top_depth_)
+        return;
+
+    depth_of_[position] = ++top_depth_;
+    is_in_z_order_ = is_in_z_order_ && position == shapes_.size() - 1;
+}
+
+void GraphicsDoc::send_to_back(ShapeHandle handle)
+{
+    const auto position = position_of(handle);
+
+    if (depth_of_[position] == bottom_depth_)
+        return;
+
+    depth_of_[position] = --bottom_depth_;
+    is_in_z_order_ = is_in_z_order_ && position == 0;
+}
+
+void GraphicsDoc::restore_z_order()
+{
+    if (is_in_z_order_)
+        return;
+
+    vector<uint32_t> order(shapes_.size());
+    iota(order.begin(), order.end(), 0u);
+    sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return depth_of_[a] < depth_of_[b]; });
+
+    vector<ShapePtr> shapes;
+    vector<uint32_t> slot_of;
+    vector<int64_t> depth_of;
+    shapes.reserve(order.size());
+    slot_of.reserve(order.size());
+    depth_of.reserve(order.size());
+
+    for (auto position : order)
+    {
+        slots_[slot_of_[position]].position = static_cast<uint32_t>(shapes.size());
+        shapes.push_back(std::move(shapes_[position]));
+        slot_of.push_back(slot_of_[position]);
+        depth_of.push_back(depth_of_[position]);
+    }
+
+    shapes_.swap(shapes);
+    slot_of_.swap(slot_of);
+    depth_of_.swap(depth_of);
+    is_in_z_order_ = true;
+}
+
+void GraphicsDoc::render(RenderSink& sink)
+{
+    restore_z_order();
+
+    for (const auto& shp : shapes_)
+        shp->draw(sink);
+
+    sink.flush();
+}
+
+vector<size_t> GraphicsDoc::query(const BoundingBox& area) const
+{
+    vector<size_t> positions;
+
+    for (auto slot : index_.query(area))
+        positions.push_back(slots_[slot].position);
+
+    sort(positions.begin(), positions.end(), [this](size_t a, size_t b) { return depth_of_[a] < depth_of_[b]; });
+
+    return positions;
+}
+
+optional<size_t> GraphicsDoc::pick(const Point& pt) const
+{
+    auto slot = index_.pick(pt, [this](SpatialIndex::Id slot) { return depth_of_[slots_[slot].position]; });
+
+    return slot ? optional<size_t>{slots_[*slot].position} : nullopt;
+}
+
+void GraphicsDoc::render_region(const BoundingBox& area, RenderSink& sink)
+{
+    restore_z_order();
+
+    for (auto position : query(area))
+        shapes_[position]->draw(sink);
+
+    sink.flush();
+}
+
+void GraphicsDoc::load(const string& filename)
+{
+    MappedFile file{filename};
+    string_view in = file.view();
+
+    for (auto shape_id = Scan::word(in); !shape_id.empty(); shape_id = Scan::word(in))
+    {
+        const auto& shape_type = shape_types_.find(shape_id);
+
+        auto shape = shape_type.create_in(memory_resource());
+        shape_type.shape_rw->read(*shape, in);
+
+        add(std::move(shape));
+    }
+}
+
+void GraphicsDoc::save(const string& filename)
+{
+    restore_z_order();
+
+    ofstream file_out{filename};
+    OutputBuffer out{file_out};
+
+    for (const auto& shp : shapes_)
+        shape_types_.find(*shp).shape_rw->write(*shp, out);
+}
+
+void GraphicsDoc::load_binary(const string& filename)
+{
+    MappedFile file{filename};
+    const auto header = Binary::read_header(file.view());
+
+    // type tags are resolved once per file
+    vector<const ShapeTypeInfo*> tagged_types;
+    tagged_types.reserve(header.type_count);
+
+    for (uint64_t i = 0; i < header.type_count; ++i)
+        tagged_types.push_back(&shape_types_.find(Binary::type_id(header, file.view(), i)));
+
+    const string_view strings = file.view().substr(header.strings_offset, header.strings_size);
+
+    shapes_.reserve(shapes_.size() + header.record_count);
+    slot_of_.reserve(slot_of_.size() + header.record_count);
+    depth_of_.reserve(depth_of_.size() + header.record_count);
+
+    for (uint64_t i = 0; i < header.record_count; ++i)
+    {
+        const auto record = Binary::read_at<Binary::ShapeRecord>(file.view(), header.records_offset + i * header.record_size);
+
+        if (record.type_tag >= header.type_count)
+            throw runtime_error("Binary drawing: unknown type tag " + to_string(record.type_tag));
+
+        const auto& shape_type = *tagged_types[record.type_tag];
+
+        auto shape = shape_type.create_in(memory_resource());
+        shape_type.shape_rw->read(*shape, record, strings);
+
+        add(std::move(shape));
+    }
+}
+
+void GraphicsDoc::save_binary(const string& filename)
+{
+    restore_z_order();
+
+    unordered_map<type_index, uint32_t> type_tags;
+    vector<Binary::TypeEntry> type_table;
+
+    vector<Binary::ShapeRecord> records(shapes_.size());
+    string strings;
+
+    for (size_t i = 0; i < shapes_.size(); ++i)
+    {
+        const auto& shape_type = shape_types_.find(*shapes_[i]);
+
+        auto [pos, is_new_type] = type_tags.emplace(shape_type.type, static_cast<uint32_t>(type_table.size()));
+
+        if (is_new_type)
+            type_table.push_back(Binary::make_type_entry(shape_type.id));
+
+        records[i].type_tag = pos->second;
+        shape_type.shape_rw->write(*shapes_[i], records[i], strings);
+    }
+
+    ofstream file_out{filename, ios::binary};
+    Binary::write_drawing(file_out, type_table, records, strings);
+
+    if (!file_out)
+        throw runtime_error("Binary drawing: cannot write file " + filename);
+}
+
+void convert_text_to_binary(const string& text_filename, const string& binary_filename, const ShapeTypeRegistry& shape_types)
+{
+    GraphicsDoc doc{shape_types};
+    doc.load(text_filename);
+    doc.save_binary(binary_filename);
+}
+
+void convert_binary_to_text(const string& binary_filename, const string& text_filename, const ShapeTypeRegistry& shape_types)
+{
+    GraphicsDoc doc{shape_types};
+    doc.load_binary(binary_filename);
+    doc.save(text_filename);
+}
@@ -0,0 +1,165 @@
+#ifndef GRAPHICS_DOC_HPP
+#define GRAPHICS_DOC_HPP
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "shape.hpp"
+#include "shape_type_registry.hpp"
+#include "spatial_index.hpp"
+
+enum class ShapeStorage
+{
+    heap,  // every shape is a separate heap allocation
+    arena  // shapes are allocated from an arena owned by the document
+};
+
+// Stable reference to a shape of a GraphicsDoc - a slot and the generation of the slot
+// when the shape was added. Stays valid while the shape is in the document; once the shape
+// is removed, the handle is stale (even when the slot is reused).
+struct ShapeHandle
+{
+    std::uint32_t slot = 0;
+    std::uint32_t generation = 0;
+
+    bool operator==(const ShapeHandle& other) const
+    {
+        return slot == other.slot && generation == other.generation;
+    }
+
+    bool operator!=(const ShapeHandle& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// Shapes are stored densely (positions 0..size-1) and referenced through a slot map.
+// Removal swaps the last shape into the hole, z-order changes only assign a new depth -
+// both are O(1). The dense storage is re-sorted by depth lazily, before the next render
+// or save, so drawing always walks the shapes contiguously. Positions change when shapes
+// are removed or reordered - keep a ShapeHandle to refer to a shape across such changes.
+class GraphicsDoc
+{
+    struct Slot
+    {
+        std::uint32_t generation = 0;
+        std::uint32_t position; // in shapes_ when occupied, otherwise the next free slot
+    };
+
+    static constexpr std::uint32_t no_slot = UINT32_MAX;
+
+    // pools on top of monotonic chunks - blocks of removed shapes are reused by new shapes,
+    // so adding and removing shapes does not grow the arena
+    struct Arena
+    {
+        std::pmr::monotonic_buffer_resource buffer;
+        std::pmr::unsynchronized_pool_resource pool{&buffer};
+
+        explicit Arena(std::size_t initial_size)
+            : buffer{initial_size}
+        {
+        }
+    };
+
+    const Drawing::ShapeTypeRegistry& shape_types_;
+    std::unique_ptr<Arena> arena_; // declared before shapes_ - outlives them
+    std::vector<Drawing::ShapePtr> shapes_;
+    std::vector<std::uint32_t> slot_of_;  // parallel to shapes_
+    std::vector<std::int64_t> depth_of_;  // parallel to shapes_ - higher is drawn later (on top)
+    std::vector<Slot> slots_;
+    std::uint32_t free_slots_ = no_slot;
+    std::int64_t top_depth_ = 0;
+    std::int64_t bottom_depth_ = 0;
+    bool is_in_z_order_ = true;   // shapes_ sorted by depth
+    Drawing::SpatialIndex index_; // bounding boxes of non-empty shapes_ (ids are slots)
+
+    std::size_t position_of(ShapeHandle handle) const;
+    void reindex(std::uint32_t slot, const Drawing::Shape& shp);
+    void restore_z_order();
+
+public:
+    explicit GraphicsDoc(const Drawing::ShapeTypeRegistry& shape_types, ShapeStorage storage = ShapeStorage::heap);
+
+    // deep copy - an arena document gets a fresh arena of its own
+    GraphicsDoc(const GraphicsDoc& source);
+    GraphicsDoc& operator=(const GraphicsDoc&) = delete;
+
+    // resource used for shapes created by the document (nullptr for heap storage)
+    std::pmr::memory_resource* memory_resource() const
+    {
+        return arena_ ? &arena_->pool : nullptr;
+    }
+
+    // adds the shape on top of the others
+    ShapeHandle add(Drawing::ShapePtr shp);
+
+    // O(1) - returns false for a stale handle
+    bool remove(ShapeHandle handle);
+
+    bool contains(ShapeHandle handle) const;
+
+    std::size_t size() const
+    {
+        return shapes_.size();
+    }
+
+    // shapes in storage order - the z-order unless shapes were removed or reordered since
+    // the last render or save (shapes moved directly, not with move(), are not re-indexed)
+    const std::vector<Drawing::ShapePtr>& shapes() const
+    {
+        return shapes_;
+    }
+
+    ShapeHandle handle(std::size_t position) const
+    {
+        const auto slot = slot_of_.at(position);
+
+        return {slot, slots_[slot].generation};
+    }
+
+    // nullptr for a stale handle
+    Drawing::Shape* find(ShapeHandle handle) const;
+
+    void move(std::size_t position, int dx, int dy);
+    void move(ShapeHandle handle, int dx, int dy);
+
+    // re-indexes a shape changed in place (e.g. members added to or moved within a ShapeGroup)
+    void refresh(std::size_t position);
+    void refresh(ShapeHandle handle);
+
+    // O(1) z-order changes
+    void bring_to_front(ShapeHandle handle);
+    void send_to_back(ShapeHandle handle);
+
+    // draws all shapes and flushes the sink once
+    void render(Drawing::RenderSink& sink);
+
+    // positions of shapes intersecting the area - in z-order
+    std::vector<std::size_t> query(const Drawing::BoundingBox& area) const;
+
+    // position of the top-most shape under the point
+    std::optional<std::size_t> pick(const Drawing::Point& pt) const;
+
+    // draws only the shapes intersecting the area (e.g. the viewport)
+    void render_region(const Drawing::BoundingBox& area, Drawing::RenderSink& sink);
+
+    // text interchange format
+    void load(const std::string& filename);
+    void save(const std::string& filename);
+
+    // binary format - see shape_readers_writers/binary_format.hpp
+    void load_binary(const std::string& filename);
+    void save_binary(const std::string& filename);
+};
+
+void convert_text_to_binary(const std::string& text_filename, const std::string& binary_filename,
+    const Drawing::ShapeTypeRegistry& shape_types);
+
+void convert_binary_to_text(const std::string& binary_filename, const std::string& text_filename,
+    const Drawing::ShapeTypeRegistry& shape_types);
+
+#endif // GRAPHICS_DOC_HPP
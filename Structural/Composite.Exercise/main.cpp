@@ -1,94 +1,40 @@
 #include <cassert>
 #include <fstream>
-#include <functional>
 #include <iostream>
-#include <memory>
-#include <typeindex>
-#include <unordered_map>
-#include <vector>
 
-#include "shape.hpp"
-#include "shape_factories.hpp"
+#include "graphics_doc.hpp"
+#include "rasterizer.hpp"
 
 using namespace std;
 using namespace Drawing;
-using namespace Drawing::IO;
 
-class GraphicsDoc
+int main()
 {
-    vector<unique_ptr<Shape>> shapes_;
-    ShapeFactory& shape_factory_;
-    ShapeRWFactory& shape_rw_factory_;
-
-public:
-    GraphicsDoc(ShapeFactory& shape_factory, ShapeRWFactory& shape_rw_factory)
-        : shape_factory_{shape_factory}, shape_rw_factory_{shape_rw_factory}
-    {
-    }
-
-    void add(unique_ptr<Shape> shp)
-    {
-        shapes_.push_back(std::move(shp));
-    }
-
-    void render()
-    {
-        for (const auto& shp : shapes_)
-            shp->draw();
-    }
-
-    void load(const string& filename)
-    {
-        ifstream file_in{filename};
-
-        if (!file_in)
-        {
-            cout << "File not found!" << endl;
-            exit(1);
-        }
-
-        while (file_in)
-        {
-            string shape_id;
-            file_in >> shape_id;
-
-            if (!file_in)
-                return;
-
-            cout << "Loading " << shape_id << "..." << endl;
+    cout << "Start..." << endl;
 
-            auto shape = shape_factory_.create(shape_id);
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shape));
+    TextRenderSink console{cout};
 
-            shape_rw->read(*shape, file_in);
+    GraphicsDoc doc(SingletonShapeTypeRegistry::instance());
 
-            shapes_.push_back(std::move(shape));
-        }
-    }
+    doc.load("drawing_composite.txt");
 
-    void save(const string& filename)
-    {
-        ofstream file_out{filename};
+    cout << "\n";
 
-        for (const auto& shp : shapes_)
-        {
-            auto shape_rw = shape_rw_factory_.create(make_type_index(*shp));
-            shape_rw->write(*shp, file_out);
-        }
-    }
-};
+    doc.render(console);
 
-int main()
-{
-    cout << "Start..." << endl;
+    doc.save("new_drawing_composite.txt");
 
-    GraphicsDoc doc(SingletonShapeFactory::instance(), SingletonShapeRWFactory::instance());
+    doc.save_binary("new_drawing_composite.drwb");
 
-    doc.load("drawing_composite.txt");
+    cout << "\nLoading binary drawing...\n";
 
-    cout << "\n";
+    GraphicsDoc binary_doc(SingletonShapeTypeRegistry::instance());
+    binary_doc.load_binary("new_drawing_composite.drwb");
+    binary_doc.render(console);
 
-    doc.render();
+    Bitmap image{320, 240};
+    rasterize(doc, image);
 
-    doc.save("new_drawing_composite.txt");
+    ofstream image_out{"new_drawing_composite.ppm", ios::binary};
+    image.write_ppm(image_out);
 }
@@ -0,0 +1,74 @@
+#include "mapped_file.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DRAWING_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace Drawing::IO;
+
+#ifdef DRAWING_HAS_MMAP
+
+MappedFile::MappedFile(const string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw runtime_error("Cannot open file: " + filename);
+
+    struct stat file_info;
+    if (::fstat(fd, &file_info) == -1)
+    {
+        ::close(fd);
+        throw runtime_error("Cannot stat file: " + filename);
+    }
+
+    size_ = static_cast<size_t>(file_info.st_size);
+
+    if (size_ > 0)
+    {
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            ::close(fd);
+            throw runtime_error("Cannot map file: " + filename);
+        }
+
+        ::madvise(address, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(address);
+    }
+
+    ::close(fd); // the mapping stays valid after closing the descriptor
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+}
+
+#else
+
+MappedFile::MappedFile(const string& filename)
+{
+    ifstream file_in{filename, ios::binary | ios::ate};
+    if (!file_in)
+        throw runtime_error("Cannot open file: " + filename);
+
+    buffer_.resize(static_cast<size_t>(file_in.tellg()));
+    file_in.seekg(0);
+    file_in.read(buffer_.data(), buffer_.size());
+
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Drawing
+{
+    namespace IO
+    {
+        // Read-only view of a whole file - memory-mapped on POSIX systems,
+        // read into a buffer elsewhere
+        class MappedFile
+        {
+            const char* data_ = nullptr;
+            std::size_t size_ = 0;
+            std::vector<char> buffer_; // fallback when mmap is not available
+
+        public:
+            explicit MappedFile(const std::string& filename);
+            ~MappedFile();
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            const char* data() const
+            {
+                return data_;
+            }
+
+            std::size_t size() const
+            {
+                return size_;
+            }
+
+            std::string_view view() const
+            {
+                return {data_, size_};
+            }
+        };
+    }
+}
+
+#endif // MAPPED_FILE_HPP
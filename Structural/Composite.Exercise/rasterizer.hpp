@@ -0,0 +1,56 @@
+#ifndef RASTERIZER_HPP
+#define RASTERIZER_HPP
+
+#include <cstddef>
+#include <thread>
+
+#include "bitmap.hpp"
+#include "graphics_doc.hpp"
+#include "render_sink.hpp"
+
+namespace Drawing
+{
+    struct Palette
+    {
+        Color rectangle = 0x1E88E5;
+        Color circle = 0xE53935;
+        Color text = 0x212121;
+    };
+
+    // Scan-converts primitives into a bitmap as horizontal spans of filled pixels.
+    // Pixel (0, 0) of the bitmap shows the drawing point `origin`.
+    class RasterRenderSink : public RenderSink
+    {
+        Bitmap& target_;
+        Point origin_;
+        Palette palette_;
+        int first_row_;
+        int last_row_; // exclusive
+        std::size_t filled_pixels_ = 0;
+
+        void fill_span(int y, int first_x, int last_x, Color color); // drawing coordinates, last_x exclusive
+
+    public:
+        explicit RasterRenderSink(Bitmap& target, const Point& origin = {}, const Palette& palette = {});
+
+        // restricts the sink to rows [first_row, last_row) of the bitmap - a tile of a parallel render
+        void clip_rows(int first_row, int last_row);
+
+        void draw_rectangle(const Point& coord, int width, int height) override;
+        void draw_circle(const Point& center, int radius) override;
+        void draw_text(const Point& coord, std::string_view text) override;
+
+        std::size_t filled_pixels() const
+        {
+            return filled_pixels_;
+        }
+    };
+
+    // Renders the part of the document covered by the bitmap. The bitmap is split into
+    // bands of tile_height rows rendered by thread_count threads; every band draws only
+    // the shapes the spatial index finds in its area. Returns the number of filled pixels.
+    std::size_t rasterize(const GraphicsDoc& doc, Bitmap& target, const Point& origin = {}, const Palette& palette = {},
+        unsigned int thread_count = std::thread::hardware_concurrency(), int tile_height = 64);
+}
+
+#endif // RASTERIZER_HPP
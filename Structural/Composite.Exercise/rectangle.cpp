@@ -15,8 +15,12 @@ Rectangle::Rectangle(int x, int y, int w, int h)
 {
 }
 
-void Rectangle::draw() const
+BoundingBox Rectangle::bounding_box() const
 {
-    std::cout << "Drawing rectangle at " << coord() << " with width: " << width_
-              << " and height: " << height_ << std::endl;
+    return {coord().x, coord().y, coord().x + width_, coord().y + height_};
+}
+
+void Rectangle::draw(RenderSink& sink) const
+{
+    sink.draw_rectangle(coord(), width_, height_);
 }
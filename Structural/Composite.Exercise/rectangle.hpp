@@ -35,7 +35,9 @@ namespace Drawing
             height_ = h;
         }
 
-        void draw() const override;
+        void draw(RenderSink& sink) const override;
+
+        BoundingBox bounding_box() const override;
     };
 }
 #endif // RECTANGLE_HPP
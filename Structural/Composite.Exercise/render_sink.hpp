@@ -0,0 +1,163 @@
+#ifndef RENDER_SINK_HPP
+#define RENDER_SINK_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "point.hpp"
+#include "shape_readers_writers/output_buffer.hpp"
+
+namespace Drawing
+{
+    // Target of rendering - shapes describe themselves with drawing primitives.
+    // A sink is not synchronized: threads rendering concurrently use separate sinks.
+    class RenderSink
+    {
+    public:
+        virtual ~RenderSink() = default;
+
+        virtual void draw_rectangle(const Point& coord, int width, int height) = 0;
+        virtual void draw_circle(const Point& center, int radius) = 0;
+        virtual void draw_text(const Point& coord, std::string_view text) = 0;
+
+        // called once at the end of rendering a document
+        virtual void flush()
+        {
+        }
+    };
+
+    // Human readable description of the primitives, buffered and written to a stream on flush
+    // (or when the buffer fills up)
+    class TextRenderSink : public RenderSink
+    {
+        std::ostream& out_;
+        IO::OutputBuffer buffer_;
+
+    public:
+        explicit TextRenderSink(std::ostream& out, std::size_t capacity = IO::OutputBuffer::default_capacity)
+            : out_{out}, buffer_{out, capacity}
+        {
+        }
+
+        void draw_rectangle(const Point& coord, int width, int height) override
+        {
+            buffer_ << "Drawing rectangle at " << coord << " with width: " << width << " and height: " << height << '\n';
+        }
+
+        void draw_circle(const Point& center, int radius) override
+        {
+            buffer_ << "Drawing a circle at " << center << " with radius " << radius << '\n';
+        }
+
+        void draw_text(const Point& coord, std::string_view text) override
+        {
+            buffer_ << "Rendering text '" << text << "' at: [" << coord.x << ", " << coord.y << "]\n";
+        }
+
+        void flush() override
+        {
+            buffer_.flush();
+            out_.flush();
+        }
+    };
+
+    // Discards the primitives - measures the cost of traversal alone
+    class NullRenderSink : public RenderSink
+    {
+        std::size_t primitive_count_ = 0;
+
+    public:
+        void draw_rectangle(const Point&, int, int) override
+        {
+            ++primitive_count_;
+        }
+
+        void draw_circle(const Point&, int) override
+        {
+            ++primitive_count_;
+        }
+
+        void draw_text(const Point&, std::string_view) override
+        {
+            ++primitive_count_;
+        }
+
+        std::size_t primitive_count() const
+        {
+            return primitive_count_;
+        }
+    };
+
+    // Records the primitives for later inspection or replay
+    class MemoryRenderSink : public RenderSink
+    {
+    public:
+        enum class Primitive
+        {
+            rectangle,
+            circle,
+            text
+        };
+
+        struct Command
+        {
+            Primitive primitive;
+            Point coord;
+            int width = 0;  // rectangle width, circle radius
+            int height = 0; // rectangle height
+            std::string text;
+        };
+
+        void draw_rectangle(const Point& coord, int width, int height) override
+        {
+            commands_.push_back(Command{Primitive::rectangle, coord, width, height, {}});
+        }
+
+        void draw_circle(const Point& center, int radius) override
+        {
+            commands_.push_back(Command{Primitive::circle, center, radius, 0, {}});
+        }
+
+        void draw_text(const Point& coord, std::string_view text) override
+        {
+            commands_.push_back(Command{Primitive::text, coord, 0, 0, std::string{text}});
+        }
+
+        const std::vector<Command>& commands() const
+        {
+            return commands_;
+        }
+
+        void replay(RenderSink& sink) const
+        {
+            for (const auto& cmd : commands_)
+            {
+                switch (cmd.primitive)
+                {
+                case Primitive::rectangle:
+                    sink.draw_rectangle(cmd.coord, cmd.width, cmd.height);
+                    break;
+                case Primitive::circle:
+                    sink.draw_circle(cmd.coord, cmd.width);
+                    break;
+                case Primitive::text:
+                    sink.draw_text(cmd.coord, cmd.text);
+                    break;
+                }
+            }
+        }
+
+        void clear()
+        {
+            commands_.clear();
+        }
+
+    private:
+        std::vector<Command> commands_;
+    };
+}
+
+#endif // RENDER_SINK_HPP
@@ -1,20 +1,88 @@
 #ifndef SHAPE_HPP
 #define SHAPE_HPP
 
+#include "bounding_box.hpp"
 #include "point.hpp"
+#include "render_sink.hpp"
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
 
 namespace Drawing
 {
+    class Shape;
+
+    // Deletes shapes created on the heap (no resource) or from a memory resource
+    struct ShapeDeleter
+    {
+        std::pmr::memory_resource* resource = nullptr;
+
+        ShapeDeleter() = default;
+
+        explicit ShapeDeleter(std::pmr::memory_resource* resource) noexcept
+            : resource{resource}
+        {
+        }
+
+        template <typename T>
+        ShapeDeleter(std::default_delete<T>) noexcept
+        {
+        }
+
+        void operator()(Shape* shp) const noexcept;
+    };
+
+    using ShapePtr = std::unique_ptr<Shape, ShapeDeleter>;
+
+    // creates a shape in the resource, or on the heap when resource is nullptr
+    template <typename T, typename... TArgs>
+    ShapePtr make_shape(std::pmr::memory_resource* resource, TArgs&&... args)
+    {
+        if (!resource)
+            return ShapePtr{new T(std::forward<TArgs>(args)...)};
+
+        void* raw_mem = resource->allocate(sizeof(T), alignof(T));
+        try
+        {
+            return ShapePtr{::new (raw_mem) T(std::forward<TArgs>(args)...), ShapeDeleter{resource}};
+        }
+        catch (...)
+        {
+            resource->deallocate(raw_mem, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+
     class Shape
     {
     public:
         virtual ~Shape() = default;
         virtual void move(int dx, int dy) = 0;
-        virtual void draw() const = 0;
+        virtual void draw(RenderSink& sink) const = 0;
+        virtual BoundingBox bounding_box() const = 0;
         virtual std::unique_ptr<Shape> clone() const = 0;
+
+        // nothing to draw and no meaningful bounds (e.g. a group without leaf shapes)
+        virtual bool is_empty() const
+        {
+            return false;
+        }
+
+        virtual ShapePtr clone(std::pmr::memory_resource* resource) const = 0;
+
+        // destroys the shape and returns its memory to the resource it was created in
+        virtual void destroy(std::pmr::memory_resource* resource) noexcept = 0;
     };
 
+    inline void ShapeDeleter::operator()(Shape* shp) const noexcept
+    {
+        if (resource)
+            shp->destroy(resource);
+        else
+            delete shp;
+    }
+
     template <typename Type, typename BaseType = Shape>
     class CloneableShape : public BaseType
     {
@@ -25,6 +93,18 @@ namespace Drawing
         {
             return std::make_unique<Type>(static_cast<const Type&>(*this));
         }
+
+        ShapePtr clone(std::pmr::memory_resource* resource) const override
+        {
+            return make_shape<Type>(resource, static_cast<const Type&>(*this));
+        }
+
+        void destroy(std::pmr::memory_resource* resource) noexcept override
+        {
+            Type* self = static_cast<Type*>(this);
+            self->~Type();
+            resource->deallocate(self, sizeof(Type), alignof(Type));
+        }
     };
 
     template <typename Type>
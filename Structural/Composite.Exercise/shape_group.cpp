@@ -1,6 +1,241 @@
 #include "shape_group.hpp"
 #include "shape_factories.hpp"
 #include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
 
 using namespace std;
 using namespace Drawing;
+
+namespace
+{
+    bool is_registered = SingletonShapeFactory::instance()
+                             .register_creator(ShapeGroup::id, &make_unique<ShapeGroup>);
+}
+
+ShapeGroup::ShapeGroup(const ShapeGroup& source)
+    : CloneableShape<ShapeGroup>{source}, open_groups_{source.open_groups_}, bounds_{source.bounds_}, has_valid_bounds_{source.has_valid_bounds_}, has_leaves_{source.has_leaves_}
+{
+    nodes_.reserve(source.nodes_.size());
+
+    for (const auto& node : source.nodes_)
+        nodes_.push_back(Node{node.shape ? node.shape->clone(nullptr) : ShapePtr{}, node.subtree_size, node.parent, node.bounds, node.has_valid_bounds, node.has_leaves});
+}
+
+ShapeGroup& ShapeGroup::operator=(const ShapeGroup& source)
+{
+    ShapeGroup temp{source};
+    *this = std::move(temp);
+
+    return *this;
+}
+
+uint32_t ShapeGroup::current_parent() const
+{
+    return open_groups_.empty() ? no_parent : open_groups_.back();
+}
+
+// open nested groups enclose every node appended to the group - so the extents of their
+// subtrees are valid (e.g. for draw() or move()) before end_group()
+void ShapeGroup::extend_open_groups(uint32_t node_count)
+{
+    for (auto group_node : open_groups_)
+        nodes_[group_node].subtree_size += node_count;
+}
+
+// a group with invalid bounds always has invalid ancestors - the walk stops at the first one
+void ShapeGroup::invalidate_bounds(uint32_t parent)
+{
+    for (auto node = parent; node != no_parent && nodes_[node].has_valid_bounds; node = nodes_[node].parent)
+        nodes_[node].has_valid_bounds = false;
+
+    has_valid_bounds_ = false;
+}
+
+BoundingBox ShapeGroup::merged_bounds(size_t first, size_t last, bool& has_leaves) const
+{
+    BoundingBox result;
+    has_leaves = false;
+
+    // direct members only - nested groups contribute their cached bounds
+    for (size_t i = first; i < last; i += nodes_[i].subtree_size)
+    {
+        const Node& node = nodes_[i];
+
+        if (!node.shape && !node.has_leaves)
+            continue; // no leaf shapes at any depth of the nested group
+
+        const BoundingBox box = node.shape ? node.shape->bounding_box() : node.bounds;
+        result = has_leaves ? merge(result, box) : box;
+        has_leaves = true;
+    }
+
+    return result;
+}
+
+void ShapeGroup::update_bounds() const
+{
+    if (has_valid_bounds_)
+        return;
+
+    // reverse preorder - members of a nested group are updated before the group
+    for (size_t i = nodes_.size(); i-- > 0;)
+    {
+        const Node& node = nodes_[i];
+
+        if (!node.shape && !node.has_valid_bounds)
+        {
+            node.bounds = merged_bounds(i + 1, i + node.subtree_size, node.has_leaves);
+            node.has_valid_bounds = true;
+        }
+    }
+
+    bounds_ = merged_bounds(0, nodes_.size(), has_leaves_);
+    has_valid_bounds_ = true;
+}
+
+void ShapeGroup::translate(size_t first, size_t last, int dx, int dy)
+{
+    for (size_t i = first; i < last; ++i)
+    {
+        Node& node = nodes_[i];
+
+        if (node.shape)
+            node.shape->move(dx, dy);
+        else if (node.has_valid_bounds)
+            node.bounds = translated(node.bounds, dx, dy);
+    }
+}
+
+void ShapeGroup::add(ShapePtr shp)
+{
+    const auto parent = current_parent();
+
+    if (typeid(*shp) == typeid(ShapeGroup))
+    {
+        auto& group = static_cast<ShapeGroup&>(*shp);
+
+        if (!group.open_groups_.empty())
+            throw logic_error("ShapeGroup: cannot add a group with open nested groups");
+
+        const auto group_node = static_cast<uint32_t>(nodes_.size());
+        const auto group_size = static_cast<uint32_t>(1 + group.nodes_.size());
+
+        nodes_.reserve(nodes_.size() + group_size);
+        nodes_.push_back(Node{ShapePtr{}, group_size, parent, group.bounds_, group.has_valid_bounds_, group.has_leaves_});
+
+        for (auto& node : group.nodes_)
+        {
+            node.parent = node.parent == no_parent ? group_node : node.parent + group_node + 1;
+            nodes_.push_back(std::move(node));
+        }
+
+        group.nodes_.clear();
+        group.has_valid_bounds_ = false;
+
+        extend_open_groups(group_size);
+    }
+    else
+    {
+        nodes_.push_back(Node{std::move(shp), 1, parent, BoundingBox{}, false, false});
+        extend_open_groups(1);
+    }
+
+    invalidate_bounds(parent);
+}
+
+void ShapeGroup::begin_group()
+{
+    const auto parent = current_parent();
+    const auto group_node = static_cast<uint32_t>(nodes_.size());
+
+    open_groups_.reserve(open_groups_.size() + 1);
+    nodes_.push_back(Node{ShapePtr{}, 1, parent, BoundingBox{}, false, false});
+    extend_open_groups(1);
+
+    // cannot throw after the reservation
+    open_groups_.push_back(group_node);
+
+    invalidate_bounds(parent);
+}
+
+void ShapeGroup::end_group()
+{
+    if (open_groups_.empty())
+        throw logic_error("ShapeGroup: no open nested group");
+
+    open_groups_.pop_back();
+}
+
+size_t ShapeGroup::size() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < nodes_.size(); i += nodes_[i].subtree_size)
+        ++count;
+
+    return count;
+}
+
+size_t ShapeGroup::member_count(size_t node) const
+{
+    size_t count = 0;
+    for (size_t i = node + 1; i < node + nodes_[node].subtree_size; i += nodes_[i].subtree_size)
+        ++count;
+
+    return count;
+}
+
+BoundingBox ShapeGroup::bounding_box(size_t node) const
+{
+    if (nodes_[node].shape)
+        return nodes_[node].shape->bounding_box();
+
+    update_bounds();
+
+    return nodes_[node].bounds;
+}
+
+bool ShapeGroup::is_empty(size_t node) const
+{
+    if (nodes_[node].shape)
+        return false;
+
+    update_bounds();
+
+    return !nodes_[node].has_leaves;
+}
+
+void ShapeGroup::move_node(size_t node, int dx, int dy)
+{
+    translate(node, node + nodes_[node].subtree_size, dx, dy);
+    invalidate_bounds(nodes_[node].parent);
+}
+
+void ShapeGroup::move(int dx, int dy)
+{
+    translate(0, nodes_.size(), dx, dy);
+
+    if (has_valid_bounds_)
+        bounds_ = translated(bounds_, dx, dy);
+}
+
+void ShapeGroup::draw(RenderSink& sink) const
+{
+    for (const auto& node : nodes_)
+        if (node.shape)
+            node.shape->draw(sink);
+}
+
+BoundingBox ShapeGroup::bounding_box() const
+{
+    update_bounds();
+
+    return bounds_;
+}
+
+bool ShapeGroup::is_empty() const
+{
+    update_bounds();
+
+    return !has_leaves_;
+}
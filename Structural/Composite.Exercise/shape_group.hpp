@@ -1,6 +1,8 @@
 #ifndef SHAPEGROUP_HPP
 #define SHAPEGROUP_HPP
 
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -8,9 +10,93 @@
 
 namespace Drawing
 {
-    // TODO - implement a composite for shapes
-    class ShapeGroup
+    // Composite of shapes stored as one flat array of nodes in preorder. A nested group
+    // is a node followed by the nodes of its members, so every subtree is a contiguous
+    // range [node, node + subtree_size) and all traversals are plain loops.
+    class ShapeGroup : public CloneableShape<ShapeGroup>
     {
+        static constexpr std::uint32_t no_parent = std::numeric_limits<std::uint32_t>::max();
+
+        struct Node
+        {
+            ShapePtr shape;             // nullptr for a nested group
+            std::uint32_t subtree_size; // nodes in the subtree including this one
+            std::uint32_t parent;       // enclosing nested group or no_parent
+            mutable BoundingBox bounds; // cached bounds of a nested group
+            mutable bool has_valid_bounds = false;
+            mutable bool has_leaves = false; // cached with the bounds
+        };
+
+        std::vector<Node> nodes_;
+        std::vector<std::uint32_t> open_groups_; // nested groups still being built
+        mutable BoundingBox bounds_;
+        mutable bool has_valid_bounds_ = false;
+        mutable bool has_leaves_ = false;
+
+        std::uint32_t current_parent() const;
+        void extend_open_groups(std::uint32_t node_count);
+        void invalidate_bounds(std::uint32_t parent);
+        BoundingBox merged_bounds(std::size_t first, std::size_t last, bool& has_leaves) const;
+        void update_bounds() const;
+        void translate(std::size_t first, std::size_t last, int dx, int dy);
+
+    public:
+        static constexpr const char* id = "ShapeGroup";
+
+        ShapeGroup() = default;
+        ShapeGroup(const ShapeGroup& source); // deep copy
+        ShapeGroup& operator=(const ShapeGroup& source);
+        ShapeGroup(ShapeGroup&&) noexcept = default;
+        ShapeGroup& operator=(ShapeGroup&&) noexcept = default;
+
+        // appends the shape to the innermost open nested group (or to this group);
+        // members of an added ShapeGroup are spliced in as a nested group
+        void add(ShapePtr shp);
+
+        // opens a nested group - shapes added until end_group() become its members
+        void begin_group();
+        void end_group();
+
+        // direct members of the group
+        std::size_t size() const;
+
+        std::size_t node_count() const
+        {
+            return nodes_.size();
+        }
+
+        bool is_group(std::size_t node) const
+        {
+            return !nodes_[node].shape;
+        }
+
+        // shape of a leaf node
+        const Shape& shape(std::size_t node) const
+        {
+            return *nodes_[node].shape;
+        }
+
+        std::size_t subtree_size(std::size_t node) const
+        {
+            return nodes_[node].subtree_size;
+        }
+
+        // direct members of a nested group node
+        std::size_t member_count(std::size_t node) const;
+
+        // bounds of a leaf or a nested group (a nested group without leaf shapes has an empty box at the origin)
+        BoundingBox bounding_box(std::size_t node) const;
+
+        // true for a nested group without leaf shapes at any depth
+        bool is_empty(std::size_t node) const;
+
+        // moves a member (with all its members) - a single update of its node range
+        void move_node(std::size_t node, int dx, int dy);
+
+        void move(int dx, int dy) override;
+        void draw(RenderSink& sink) const override;
+        BoundingBox bounding_box() const override;
+        bool is_empty() const override;
     };
 }
 
@@ -0,0 +1,215 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Drawing
+{
+    namespace IO
+    {
+        namespace Binary
+        {
+            // Layout of a binary drawing file (all integers are little-endian):
+            //
+            //   FileHeader
+            //   TypeEntry[type_count]      - shape ids, a record's type_tag is an index into this table
+            //   ShapeRecord[record_count]  - fixed-width records in document order
+            //   char[strings_size]         - string pool referenced by records (e.g. Text content, ShapeGroup members)
+
+            constexpr std::array<char, 4> magic = {'D', 'R', 'W', 'B'};
+            constexpr std::uint32_t current_version = 1;
+            constexpr std::size_t max_id_length = 31;
+
+            struct FileHeader
+            {
+                std::array<char, 4> magic;
+                std::uint32_t version;
+                std::uint32_t type_count;
+                std::uint32_t record_size;
+                std::uint64_t record_count;
+                std::uint64_t type_table_offset;
+                std::uint64_t records_offset;
+                std::uint64_t strings_offset;
+                std::uint64_t strings_size;
+            };
+
+            struct TypeEntry
+            {
+                std::array<char, max_id_length + 1> id; // zero-terminated
+            };
+
+            struct ShapeRecord
+            {
+                std::uint32_t type_tag;
+                std::int32_t x;
+                std::int32_t y;
+                std::array<std::int32_t, 3> params; // meaning depends on the shape type
+            };
+
+            static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) == 56);
+            static_assert(std::is_trivially_copyable_v<TypeEntry> && sizeof(TypeEntry) == 32);
+            static_assert(std::is_trivially_copyable_v<ShapeRecord> && sizeof(ShapeRecord) == 24);
+
+            inline bool is_little_endian()
+            {
+                const std::uint16_t probe = 1;
+                unsigned char first_byte;
+                std::memcpy(&first_byte, &probe, 1);
+
+                return first_byte == 1;
+            }
+
+            // unaligned read - the caller checks the bounds
+            template <typename T>
+            T read_at(std::string_view file, std::uint64_t offset)
+            {
+                T value;
+                std::memcpy(&value, file.data() + offset, sizeof(T));
+
+                return value;
+            }
+
+            // validated header of a whole file - throws std::runtime_error
+            inline FileHeader read_header(std::string_view file)
+            {
+                if (!is_little_endian())
+                    throw std::runtime_error("Binary drawing: big-endian platforms are not supported");
+
+                if (file.size() < sizeof(FileHeader))
+                    throw std::runtime_error("Binary drawing: file too short");
+
+                auto header = read_at<FileHeader>(file, 0);
+
+                if (header.magic != magic)
+                    throw std::runtime_error("Binary drawing: bad magic");
+
+                if (header.version != current_version)
+                    throw std::runtime_error("Binary drawing: unsupported version " + std::to_string(header.version));
+
+                // newer minor layouts may only append fields to a record
+                if (header.record_size < sizeof(ShapeRecord))
+                    throw std::runtime_error("Binary drawing: record size too small");
+
+                auto fits = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t item_size) {
+                    return offset <= file.size() && count <= (file.size() - offset) / item_size;
+                };
+
+                if (!fits(header.type_table_offset, header.type_count, sizeof(TypeEntry))
+                    || !fits(header.records_offset, header.record_count, header.record_size)
+                    || !fits(header.strings_offset, header.strings_size, 1))
+                    throw std::runtime_error("Binary drawing: section out of file bounds");
+
+                return header;
+            }
+
+            // id of a type table entry (zero-terminated or max_id_length long)
+            inline std::string_view type_id(const FileHeader& header, std::string_view file, std::uint64_t type_tag)
+            {
+                const char* id = file.data() + header.type_table_offset + type_tag * sizeof(TypeEntry);
+
+                const void* end = std::memchr(id, '\0', max_id_length);
+
+                return {id, end ? static_cast<std::size_t>(static_cast<const char*>(end) - id) : max_id_length};
+            }
+
+            // string pool offsets & sizes are kept in int32 params and read back as uint32
+            // - throws std::runtime_error when the value does not fit
+            inline std::int32_t pool_param(std::size_t value)
+            {
+                if (value > std::numeric_limits<std::uint32_t>::max())
+                    throw std::runtime_error("Binary drawing: string pool exceeds 4 GiB");
+
+                const auto bits = static_cast<std::uint32_t>(value);
+                std::int32_t param;
+                std::memcpy(&param, &bits, sizeof(param));
+
+                return param;
+            }
+
+            // counts are kept in int32 params - throws std::runtime_error when the value does not fit
+            inline std::int32_t count_param(std::size_t value)
+            {
+                if (value > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                    throw std::runtime_error("Binary drawing: count out of range: " + std::to_string(value));
+
+                return static_cast<std::int32_t>(value);
+            }
+
+            // throws std::runtime_error for ids longer than max_id_length
+            inline TypeEntry make_type_entry(std::string_view id)
+            {
+                if (id.size() > max_id_length)
+                    throw std::runtime_error("Binary drawing: shape id too long: " + std::string(id));
+
+                TypeEntry entry{};
+                id.copy(entry.id.data(), id.size());
+
+                return entry;
+            }
+
+            // writes a whole file - the caller checks the state of the stream
+            inline void write_drawing(std::ostream& out, const std::vector<TypeEntry>& type_table,
+                const std::vector<ShapeRecord>& records, const std::string& strings)
+            {
+                if (!is_little_endian())
+                    throw std::runtime_error("Binary drawing: big-endian platforms are not supported");
+
+                FileHeader header{};
+                header.magic = magic;
+                header.version = current_version;
+                header.type_count = static_cast<std::uint32_t>(type_table.size());
+                header.record_size = sizeof(ShapeRecord);
+                header.record_count = records.size();
+                header.type_table_offset = sizeof(FileHeader);
+                header.records_offset = header.type_table_offset + type_table.size() * sizeof(TypeEntry);
+                header.strings_offset = header.records_offset + records.size() * sizeof(ShapeRecord);
+                header.strings_size = strings.size();
+
+                out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                out.write(reinterpret_cast<const char*>(type_table.data()), type_table.size() * sizeof(TypeEntry));
+                out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ShapeRecord));
+                out.write(strings.data(), strings.size());
+            }
+
+            // Members of a ShapeGroup are stored in the string pool as a block of entries in preorder:
+            // uint8 id length, id characters, ShapeRecord (a nested group has its member count in params[0])
+            struct MemberEntry
+            {
+                std::string_view id;
+                ShapeRecord record;
+            };
+
+            // consumes an entry from the front of the block - throws std::runtime_error when truncated
+            inline MemberEntry next_member(std::string_view& block)
+            {
+                if (block.empty() || block.size() < 1u + static_cast<unsigned char>(block[0]) + sizeof(ShapeRecord))
+                    throw std::runtime_error("Binary drawing: truncated group members");
+
+                const std::size_t id_length = static_cast<unsigned char>(block[0]);
+
+                MemberEntry entry{block.substr(1, id_length), read_at<ShapeRecord>(block, 1 + id_length)};
+                block.remove_prefix(1 + id_length + sizeof(ShapeRecord));
+
+                return entry;
+            }
+
+            inline void append_member(std::string& block, std::string_view id, const ShapeRecord& record)
+            {
+                block += static_cast<char>(id.size());
+                block += id;
+                block.append(reinterpret_cast<const char*>(&record), sizeof(record));
+            }
+        }
+    }
+}
+
+#endif // BINARY_FORMAT_HPP
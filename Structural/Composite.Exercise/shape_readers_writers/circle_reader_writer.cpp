@@ -1,6 +1,8 @@
 #include "circle_reader_writer.hpp"
 #include "../circle.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
+#include "scanner.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -10,6 +12,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Circle>(), [] { return make_unique<CircleReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Circle, CircleReaderWriter>();
 }
 
 void CircleReaderWriter::read(Shape& shp, std::istream& in)
@@ -30,3 +34,35 @@ void CircleReaderWriter::write(const Shape& shp, ostream& out)
 
     out << Circle::id << " " << c.coord() << " " << c.radius() << "\n";
 }
+
+void CircleReaderWriter::read(Shape& shp, std::string_view& in)
+{
+    Circle& c = static_cast<Circle&>(shp);
+
+    c.set_coord(Scan::point(in));
+    c.set_radius(Scan::integer(in));
+}
+
+void CircleReaderWriter::write(const Shape& shp, OutputBuffer& out)
+{
+    const Circle& c = static_cast<const Circle&>(shp);
+
+    out << Circle::id << ' ' << c.coord() << ' ' << c.radius() << '\n';
+}
+
+void CircleReaderWriter::read(Shape& shp, const Binary::ShapeRecord& record, std::string_view /*strings*/)
+{
+    Circle& c = static_cast<Circle&>(shp);
+
+    c.set_coord(Point{record.x, record.y});
+    c.set_radius(record.params[0]);
+}
+
+void CircleReaderWriter::write(const Shape& shp, Binary::ShapeRecord& record, std::string& /*strings*/)
+{
+    const Circle& c = static_cast<const Circle&>(shp);
+
+    record.x = c.coord().x;
+    record.y = c.coord().y;
+    record.params = {c.radius(), 0, 0};
+}
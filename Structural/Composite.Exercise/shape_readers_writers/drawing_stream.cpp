@@ -0,0 +1,253 @@
+#include "drawing_stream.hpp"
+#include "../circle.hpp"
+#include "../mapped_file.hpp"
+#include "../rectangle.hpp"
+#include "../shape_group.hpp"
+#include "../square.hpp"
+#include "../text.hpp"
+#include "binary_format.hpp"
+#include "scanner.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace Drawing;
+using namespace Drawing::IO;
+
+namespace
+{
+    enum class RecordKind
+    {
+        rectangle,
+        square,
+        circle,
+        text,
+        group
+    };
+
+    RecordKind kind_of(string_view id)
+    {
+        if (id == Rectangle::id)
+            return RecordKind::rectangle;
+        if (id == Square::id)
+            return RecordKind::square;
+        if (id == Circle::id)
+            return RecordKind::circle;
+        if (id == Text::id)
+            return RecordKind::text;
+        if (id == ShapeGroup::id)
+            return RecordKind::group;
+
+        throw runtime_error("Drawing stream: unsupported shape id " + string(id));
+    }
+
+    // Tracks members left in the open groups - the depth is the only state that grows
+    class GroupTracker
+    {
+        DrawingVisitor& visitor_;
+        vector<int> remaining_;
+
+    public:
+        explicit GroupTracker(DrawingVisitor& visitor)
+            : visitor_{visitor}
+        {
+        }
+
+        // called before every record
+        void next_record()
+        {
+            if (!remaining_.empty())
+                --remaining_.back();
+        }
+
+        void begin_group(int member_count)
+        {
+            if (member_count < 0)
+                throw runtime_error("ShapeGroup: negative member count");
+
+            visitor_.on_group_begin(member_count);
+            remaining_.push_back(member_count);
+        }
+
+        // called after every record
+        void close_complete_groups()
+        {
+            while (!remaining_.empty() && remaining_.back() == 0)
+            {
+                remaining_.pop_back();
+                visitor_.on_group_end();
+            }
+        }
+
+        bool has_open_groups() const
+        {
+            return !remaining_.empty();
+        }
+    };
+
+    string_view string_at(string_view strings, int32_t offset, int32_t length)
+    {
+        const auto first = static_cast<uint32_t>(offset);
+        const auto count = static_cast<uint32_t>(length);
+
+        if (first > strings.size() || count > strings.size() - first)
+            throw runtime_error("Binary record out of string pool bounds");
+
+        return strings.substr(first, count);
+    }
+
+    // a record of any kind other than a group
+    void visit_shape(RecordKind kind, const Binary::ShapeRecord& record, string_view strings, DrawingVisitor& visitor)
+    {
+        const Point coord{record.x, record.y};
+
+        switch (kind)
+        {
+        case RecordKind::rectangle:
+            visitor.on_rectangle(coord, record.params[0], record.params[1]);
+            break;
+        case RecordKind::square:
+            visitor.on_square(coord, record.params[0]);
+            break;
+        case RecordKind::circle:
+            visitor.on_circle(coord, record.params[0]);
+            break;
+        case RecordKind::text:
+            visitor.on_text(coord, string_at(strings, record.params[0], record.params[1]));
+            break;
+        case RecordKind::group:
+            break;
+        }
+    }
+
+    // a group record - its members are stored in preorder in a block of the string pool
+    void visit_group(const Binary::ShapeRecord& record, string_view strings, DrawingVisitor& visitor)
+    {
+        string_view block = string_at(strings, record.params[0], record.params[1]);
+
+        GroupTracker groups{visitor};
+        groups.begin_group(record.params[2]);
+        groups.close_complete_groups();
+
+        while (groups.has_open_groups())
+        {
+            groups.next_record();
+
+            const auto [member_id, member_record] = Binary::next_member(block);
+            const auto kind = kind_of(member_id);
+
+            if (kind == RecordKind::group)
+                groups.begin_group(member_record.params[0]);
+            else
+                visit_shape(kind, member_record, strings, visitor);
+
+            groups.close_complete_groups();
+        }
+    }
+}
+
+void Drawing::IO::stream_text(const string& filename, DrawingVisitor& visitor)
+{
+    MappedFile file{filename};
+    string_view in = file.view();
+
+    GroupTracker groups{visitor};
+
+    for (auto shape_id = Scan::word(in); !shape_id.empty(); shape_id = Scan::word(in))
+    {
+        groups.next_record();
+
+        switch (kind_of(shape_id))
+        {
+        case RecordKind::rectangle:
+        {
+            const auto coord = Scan::point(in);
+            const int width = Scan::integer(in);
+            visitor.on_rectangle(coord, width, Scan::integer(in));
+            break;
+        }
+        case RecordKind::square:
+        {
+            const auto coord = Scan::point(in);
+            visitor.on_square(coord, Scan::integer(in));
+            break;
+        }
+        case RecordKind::circle:
+        {
+            const auto center = Scan::point(in);
+            visitor.on_circle(center, Scan::integer(in));
+            break;
+        }
+        case RecordKind::text:
+        {
+            const auto coord = Scan::point(in);
+            visitor.on_text(coord, Scan::word(in));
+            break;
+        }
+        case RecordKind::group:
+            groups.begin_group(Scan::integer(in));
+            break;
+        }
+
+        groups.close_complete_groups();
+    }
+
+    if (groups.has_open_groups())
+        throw runtime_error("ShapeGroup: missing members");
+}
+
+void Drawing::IO::stream_binary(const string& filename, DrawingVisitor& visitor)
+{
+    MappedFile file{filename};
+    const string_view content = file.view();
+    const auto header = Binary::read_header(content);
+
+    vector<RecordKind> tagged_kinds;
+    tagged_kinds.reserve(header.type_count);
+
+    for (uint64_t i = 0; i < header.type_count; ++i)
+        tagged_kinds.push_back(kind_of(Binary::type_id(header, content, i)));
+
+    const string_view strings = content.substr(header.strings_offset, header.strings_size);
+
+    for (uint64_t i = 0; i < header.record_count; ++i)
+    {
+        const auto record = Binary::read_at<Binary::ShapeRecord>(content, header.records_offset + i * header.record_size);
+
+        if (record.type_tag >= header.type_count)
+            throw runtime_error("Binary drawing: unknown type tag " + to_string(record.type_tag));
+
+        const auto kind = tagged_kinds[record.type_tag];
+
+        if (kind == RecordKind::group)
+            visit_group(record, strings, visitor);
+        else
+            visit_shape(kind, record, strings, visitor);
+    }
+}
+
+void TextDrawingWriter::on_rectangle(const Point& coord, int width, int height)
+{
+    out_ << Rectangle::id << ' ' << coord << ' ' << width << ' ' << height << '\n';
+}
+
+void TextDrawingWriter::on_square(const Point& coord, int size)
+{
+    out_ << Square::id << ' ' << coord << ' ' << size << '\n';
+}
+
+void TextDrawingWriter::on_circle(const Point& center, int radius)
+{
+    out_ << Circle::id << ' ' << center << ' ' << radius << '\n';
+}
+
+void TextDrawingWriter::on_text(const Point& coord, string_view text)
+{
+    out_ << Text::id << ' ' << coord << ' ' << text << '\n';
+}
+
+void TextDrawingWriter::on_group_begin(int member_count)
+{
+    out_ << ShapeGroup::id << ' ' << member_count << '\n';
+}
@@ -0,0 +1,80 @@
+#ifndef DRAWING_STREAM_HPP
+#define DRAWING_STREAM_HPP
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "../point.hpp"
+#include "output_buffer.hpp"
+
+namespace Drawing
+{
+    namespace IO
+    {
+        // Receives the records of a drawing read with stream_text() or stream_binary().
+        // Fields are passed as values and views into the file - valid only during the call.
+        class DrawingVisitor
+        {
+        public:
+            virtual ~DrawingVisitor() = default;
+
+            virtual void on_rectangle(const Point& /*coord*/, int /*width*/, int /*height*/)
+            {
+            }
+
+            virtual void on_square(const Point& /*coord*/, int /*size*/)
+            {
+            }
+
+            virtual void on_circle(const Point& /*center*/, int /*radius*/)
+            {
+            }
+
+            virtual void on_text(const Point& /*coord*/, std::string_view /*text*/)
+            {
+            }
+
+            // records of the members follow until the matching on_group_end()
+            virtual void on_group_begin(int /*member_count*/)
+            {
+            }
+
+            virtual void on_group_end()
+            {
+            }
+        };
+
+        // Walk a drawing of built-in shapes (Rectangle, Square, Circle, Text, ShapeGroup)
+        // without creating shapes - nothing is allocated per record, so aggregates, filters
+        // and conversions run in constant memory. The file is memory-mapped and read sequentially.
+        // Throw std::runtime_error for malformed files and unsupported shape ids.
+        void stream_text(const std::string& filename, DrawingVisitor& visitor);
+        void stream_binary(const std::string& filename, DrawingVisitor& visitor);
+
+        // Writes the visited records in the text format
+        class TextDrawingWriter : public DrawingVisitor
+        {
+            OutputBuffer out_;
+
+        public:
+            explicit TextDrawingWriter(std::ostream& out)
+                : out_{out}
+            {
+            }
+
+            void on_rectangle(const Point& coord, int width, int height) override;
+            void on_square(const Point& coord, int size) override;
+            void on_circle(const Point& center, int radius) override;
+            void on_text(const Point& coord, std::string_view text) override;
+            void on_group_begin(int member_count) override;
+
+            void flush()
+            {
+                out_.flush();
+            }
+        };
+    }
+}
+
+#endif // DRAWING_STREAM_HPP
@@ -0,0 +1,104 @@
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "../point.hpp"
+
+namespace Drawing
+{
+    namespace IO
+    {
+        // Formats text output with std::to_chars into a reusable buffer and
+        // hands it to the stream in large blocks (one write per block instead of
+        // a formatted insertion - and with std::endl a flush - per field)
+        class OutputBuffer
+        {
+            std::ostream& out_;
+            std::vector<char> buffer_;
+            std::size_t size_ = 0;
+
+            static constexpr std::size_t max_int_length = std::numeric_limits<int>::digits10 + 2;
+
+            void reserve(std::size_t count)
+            {
+                if (buffer_.size() - size_ < count)
+                    flush();
+            }
+
+        public:
+            static constexpr std::size_t default_capacity = 1 << 20;
+
+            explicit OutputBuffer(std::ostream& out, std::size_t capacity = default_capacity)
+                : out_{out}, buffer_(std::max(capacity, 2 * max_int_length + 3))
+            {
+            }
+
+            OutputBuffer(const OutputBuffer&) = delete;
+            OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+            ~OutputBuffer()
+            {
+                flush();
+            }
+
+            OutputBuffer& operator<<(std::string_view text)
+            {
+                if (text.size() > buffer_.size())
+                {
+                    flush();
+                    out_.write(text.data(), text.size());
+                    return *this;
+                }
+
+                reserve(text.size());
+                std::memcpy(buffer_.data() + size_, text.data(), text.size());
+                size_ += text.size();
+
+                return *this;
+            }
+
+            OutputBuffer& operator<<(char c)
+            {
+                reserve(1);
+                buffer_[size_++] = c;
+
+                return *this;
+            }
+
+            OutputBuffer& operator<<(int value)
+            {
+                reserve(max_int_length);
+                auto [end, error] = std::to_chars(buffer_.data() + size_, buffer_.data() + buffer_.size(), value);
+                size_ = end - buffer_.data();
+
+                return *this;
+            }
+
+            // same format as operator<<(std::ostream&, const Point&)
+            OutputBuffer& operator<<(const Point& pt)
+            {
+                reserve(2 * max_int_length + 3);
+
+                return *this << '[' << pt.x << ',' << pt.y << ']';
+            }
+
+            void flush()
+            {
+                if (size_ > 0)
+                {
+                    out_.write(buffer_.data(), size_);
+                    size_ = 0;
+                }
+            }
+        };
+    }
+}
+
+#endif // OUTPUT_BUFFER_HPP
@@ -1,6 +1,8 @@
 #include "rectangle_reader_writer.hpp"
 #include "../rectangle.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
+#include "scanner.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -10,6 +12,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Rectangle>(), [] { return make_unique<RectangleReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Rectangle, RectangleReaderWriter>();
 }
 
 void RectangleReaderWriter::read(Shape& shp, std::istream& in)
@@ -32,3 +36,37 @@ void RectangleReaderWriter::write(const Shape& shp, std::ostream& out)
 
     out << Rectangle::id << " " << rect.coord() << " " << rect.width() << " " << rect.height() << std::endl;
 }
+
+void RectangleReaderWriter::read(Shape& shp, std::string_view& in)
+{
+    Rectangle& rect = static_cast<Rectangle&>(shp);
+
+    rect.set_coord(Scan::point(in));
+    rect.set_width(Scan::integer(in));
+    rect.set_height(Scan::integer(in));
+}
+
+void RectangleReaderWriter::write(const Shape& shp, OutputBuffer& out)
+{
+    const Rectangle& rect = static_cast<const Rectangle&>(shp);
+
+    out << Rectangle::id << ' ' << rect.coord() << ' ' << rect.width() << ' ' << rect.height() << '\n';
+}
+
+void RectangleReaderWriter::read(Shape& shp, const Binary::ShapeRecord& record, std::string_view /*strings*/)
+{
+    Rectangle& rect = static_cast<Rectangle&>(shp);
+
+    rect.set_coord(Point{record.x, record.y});
+    rect.set_width(record.params[0]);
+    rect.set_height(record.params[1]);
+}
+
+void RectangleReaderWriter::write(const Shape& shp, Binary::ShapeRecord& record, std::string& /*strings*/)
+{
+    const Rectangle& rect = static_cast<const Rectangle&>(shp);
+
+    record.x = rect.coord().x;
+    record.y = rect.coord().y;
+    record.params = {rect.width(), rect.height(), 0};
+}
@@ -0,0 +1,85 @@
+#include "scanner.hpp"
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace Drawing;
+using namespace Drawing::IO;
+
+namespace
+{
+    constexpr char opening_bracket = '[';
+    constexpr char closing_bracket = ']';
+    constexpr char comma = ',';
+
+    bool is_whitespace(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    [[noreturn]] void scan_error(string_view in, const char* expected)
+    {
+        throw runtime_error("Scan error: expected " + string(expected) + " at '" + string(in.substr(0, 16)) + "'");
+    }
+
+    void expect(string_view& in, char c)
+    {
+        Scan::skip_whitespace(in);
+
+        if (in.empty() || in.front() != c)
+            scan_error(in, string{'\'', c, '\''}.c_str());
+
+        in.remove_prefix(1);
+    }
+}
+
+void Scan::skip_whitespace(string_view& in)
+{
+    size_t i = 0;
+    while (i < in.size() && is_whitespace(in[i]))
+        ++i;
+
+    in.remove_prefix(i);
+}
+
+string_view Scan::word(string_view& in)
+{
+    skip_whitespace(in);
+
+    size_t length = 0;
+    while (length < in.size() && !is_whitespace(in[length]))
+        ++length;
+
+    auto result = in.substr(0, length);
+    in.remove_prefix(length);
+
+    return result;
+}
+
+int Scan::integer(string_view& in)
+{
+    skip_whitespace(in);
+
+    int value;
+    auto [end, error] = from_chars(in.data(), in.data() + in.size(), value);
+
+    if (error != errc{})
+        scan_error(in, "integer");
+
+    in.remove_prefix(end - in.data());
+
+    return value;
+}
+
+Point Scan::point(string_view& in)
+{
+    expect(in, opening_bracket);
+    int x = integer(in);
+    expect(in, comma);
+    int y = integer(in);
+    expect(in, closing_bracket);
+
+    return Point{x, y};
+}
@@ -0,0 +1,29 @@
+#ifndef SCANNER_HPP
+#define SCANNER_HPP
+
+#include <string_view>
+
+#include "../point.hpp"
+
+namespace Drawing
+{
+    namespace IO
+    {
+        // Allocation-free parsing of the text drawing format. Every function consumes
+        // the parsed token (and preceding whitespace) from the front of the view
+        // and throws std::runtime_error on malformed input.
+        namespace Scan
+        {
+            void skip_whitespace(std::string_view& in);
+
+            // returns an empty view at the end of input
+            std::string_view word(std::string_view& in);
+
+            int integer(std::string_view& in);
+
+            Point point(std::string_view& in);
+        }
+    }
+}
+
+#endif // SCANNER_HPP
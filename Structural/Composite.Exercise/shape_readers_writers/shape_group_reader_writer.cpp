@@ -1,6 +1,217 @@
 #include "shape_group_reader_writer.hpp"
+#include "../shape_type_registry.hpp"
+#include "scanner.hpp"
+
+#include <stdexcept>
+#include <vector>
 
 using namespace std;
 using namespace Drawing;
 using namespace Drawing::IO;
 
+namespace
+{
+    bool is_registered = SingletonShapeRWFactory::instance()
+                             .register_creator(make_type_index<ShapeGroup>(), [] { return make_unique<ShapeGroupReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<ShapeGroup, ShapeGroupReaderWriter>();
+
+    // Reads the members of a group without recursion. next_member(group) reads one member
+    // record: it either adds a shape to the group or opens a nested group and returns
+    // its member count (-1 for a plain shape).
+    template <typename ReadMember>
+    void read_members(ShapeGroup& group, int member_count, ReadMember next_member)
+    {
+        if (member_count < 0)
+            throw runtime_error("ShapeGroup: negative member count");
+
+        vector<int> remaining{member_count}; // members left to read in every open group
+
+        while (!remaining.empty())
+        {
+            if (remaining.back() == 0)
+            {
+                remaining.pop_back();
+
+                if (!remaining.empty()) // the bottom frame is the group itself
+                    group.end_group();
+
+                continue;
+            }
+
+            --remaining.back();
+
+            const int nested_member_count = next_member(group);
+
+            if (nested_member_count >= 0)
+                remaining.push_back(nested_member_count);
+        }
+    }
+
+    // Writes the members in preorder: write_group(node) for nested groups, write_shape(shape) for the others
+    template <typename WriteGroup, typename WriteShape>
+    void write_members(const ShapeGroup& group, WriteGroup write_group, WriteShape write_shape)
+    {
+        for (size_t node = 0; node < group.node_count(); ++node)
+        {
+            if (group.is_group(node))
+                write_group(group.member_count(node));
+            else
+                write_shape(group.shape(node));
+        }
+    }
+}
+
+void ShapeGroupReaderWriter::read(Shape& shp, istream& in)
+{
+    ShapeGroup& group = static_cast<ShapeGroup&>(shp);
+    const auto& shape_types = SingletonShapeTypeRegistry::instance();
+
+    int member_count;
+    if (!(in >> member_count))
+        throw runtime_error("ShapeGroup: expected member count");
+
+    read_members(group, member_count, [&](ShapeGroup& group) {
+        string member_id;
+        if (!(in >> member_id))
+            throw runtime_error("ShapeGroup: missing members");
+
+        if (member_id == ShapeGroup::id)
+        {
+            int nested_member_count;
+            if (!(in >> nested_member_count) || nested_member_count < 0)
+                throw runtime_error("ShapeGroup: expected member count");
+
+            group.begin_group();
+            return nested_member_count;
+        }
+
+        const auto& shape_type = shape_types.find(member_id);
+        auto member = shape_type.create_in(nullptr);
+        shape_type.shape_rw->read(*member, in);
+        group.add(std::move(member));
+
+        return -1;
+    });
+}
+
+void ShapeGroupReaderWriter::write(const Shape& shp, ostream& out)
+{
+    const ShapeGroup& group = static_cast<const ShapeGroup&>(shp);
+    const auto& shape_types = SingletonShapeTypeRegistry::instance();
+
+    out << ShapeGroup::id << " " << group.size() << "\n";
+
+    write_members(
+        group,
+        [&](size_t member_count) { out << ShapeGroup::id << " " << member_count << "\n"; },
+        [&](const Shape& member) { shape_types.find(member).shape_rw->write(member, out); });
+}
+
+void ShapeGroupReaderWriter::read(Shape& shp, string_view& in)
+{
+    ShapeGroup& group = static_cast<ShapeGroup&>(shp);
+    const auto& shape_types = SingletonShapeTypeRegistry::instance();
+
+    read_members(group, Scan::integer(in), [&](ShapeGroup& group) {
+        const auto member_id = Scan::word(in);
+
+        if (member_id.empty())
+            throw runtime_error("ShapeGroup: missing members");
+
+        if (member_id == ShapeGroup::id)
+        {
+            const int nested_member_count = Scan::integer(in);
+            if (nested_member_count < 0)
+                throw runtime_error("ShapeGroup: negative member count");
+
+            group.begin_group();
+            return nested_member_count;
+        }
+
+        const auto& shape_type = shape_types.find(member_id);
+        auto member = shape_type.create_in(nullptr);
+        shape_type.shape_rw->read(*member, in);
+        group.add(std::move(member));
+
+        return -1;
+    });
+}
+
+void ShapeGroupReaderWriter::write(const Shape& shp, OutputBuffer& out)
+{
+    const ShapeGroup& group = static_cast<const ShapeGroup&>(shp);
+    const auto& shape_types = SingletonShapeTypeRegistry::instance();
+
+    out << ShapeGroup::id << ' ' << static_cast<int>(group.size()) << '\n';
+
+    write_members(
+        group,
+        [&](size_t member_count) { out << ShapeGroup::id << ' ' << static_cast<int>(member_count) << '\n'; },
+        [&](const Shape& member) { shape_types.find(member).shape_rw->write(member, out); });
+}
+
+void ShapeGroupReaderWriter::read(Shape& shp, const Binary::ShapeRecord& record, string_view strings)
+{
+    ShapeGroup& group = static_cast<ShapeGroup&>(shp);
+    const auto& shape_types = SingletonShapeTypeRegistry::instance();
+
+    const auto offset = static_cast<uint32_t>(record.params[0]);
+    const auto size = static_cast<uint32_t>(record.params[1]);
+
+    if (offset > strings.size() || size > strings.size() - offset)
+        throw runtime_error("Binary drawing: group members out of bounds");
+
+    string_view block = strings.substr(offset, size);
+
+    read_members(group, record.params[2], [&](ShapeGroup& group) {
+        const auto [member_id, member_record] = Binary::next_member(block);
+
+        if (member_id == ShapeGroup::id)
+        {
+            if (member_record.params[0] < 0)
+                throw runtime_error("ShapeGroup: negative member count");
+
+            group.begin_group();
+            return static_cast<int>(member_record.params[0]);
+        }
+
+        const auto& shape_type = shape_types.find(member_id);
+        auto member = shape_type.create_in(nullptr);
+        shape_type.shape_rw->read(*member, member_record, strings);
+        group.add(std::move(member));
+
+        return -1;
+    });
+}
+
+void ShapeGroupReaderWriter::write(const Shape& shp, Binary::ShapeRecord& record, string& strings)
+{
+    const ShapeGroup& group = static_cast<const ShapeGroup&>(shp);
+    const auto& shape_types = SingletonShapeTypeRegistry::instance();
+
+    // members may add their own strings to the pool - the block is appended after them
+    string block;
+
+    write_members(
+        group,
+        [&](size_t member_count) {
+            Binary::ShapeRecord group_record{};
+            group_record.params = {Binary::count_param(member_count), 0, 0};
+            Binary::append_member(block, ShapeGroup::id, group_record);
+        },
+        [&](const Shape& member) {
+            const auto& shape_type = shape_types.find(member);
+
+            if (shape_type.id.size() > Binary::max_id_length)
+                throw runtime_error("Binary drawing: shape id too long: " + shape_type.id);
+
+            Binary::ShapeRecord member_record{};
+            shape_type.shape_rw->write(member, member_record, strings);
+            Binary::append_member(block, shape_type.id, member_record);
+        });
+
+    record.params = {Binary::pool_param(strings.size()), Binary::pool_param(block.size()), Binary::count_param(group.size())};
+
+    strings += block;
+}
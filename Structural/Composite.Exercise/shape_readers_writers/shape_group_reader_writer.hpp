@@ -9,8 +9,19 @@ namespace Drawing
 {
     namespace IO
     {
-        class ShapeGroupReaderWriter
+        // Text format: "ShapeGroup N" followed by the records of its N members (nested groups
+        // included). Binary format: the record points to a block in the file's string pool
+        // holding the member records in preorder, each prefixed with its shape id.
+        // Nested groups are read with an explicit stack - there is no recursion depth limit.
+        class ShapeGroupReaderWriter : public ShapeReaderWriter
         {
+        public:
+            void read(Shape& shp, std::istream& in) override;
+            void write(const Shape& shp, std::ostream& out) override;
+            void read(Shape& shp, std::string_view& in) override;
+            void write(const Shape& shp, OutputBuffer& out) override;
+            void read(Shape& shp, const Binary::ShapeRecord& record, std::string_view strings) override;
+            void write(const Shape& shp, Binary::ShapeRecord& record, std::string& strings) override;
         };
     }
 }
@@ -2,6 +2,10 @@
 #define SHAPE_READER_WRITER_HPP
 
 #include "../shape.hpp"
+#include "binary_format.hpp"
+#include "output_buffer.hpp"
+#include <string>
+#include <string_view>
 
 namespace Drawing
 {
@@ -11,8 +15,18 @@ namespace Drawing
         {
         public:
             virtual ~ShapeReaderWriter() = default;
+
+            // text interchange format
             virtual void read(Shape& shp, std::istream& in) = 0;
             virtual void write(const Shape& shp, std::ostream& out) = 0;
+
+            // allocation-free text parsing - consumes the record from the front of in
+            virtual void read(Shape& shp, std::string_view& in) = 0;
+            virtual void write(const Shape& shp, OutputBuffer& out) = 0;
+
+            // binary format - strings is the string pool of the file
+            virtual void read(Shape& shp, const Binary::ShapeRecord& record, std::string_view strings) = 0;
+            virtual void write(const Shape& shp, Binary::ShapeRecord& record, std::string& strings) = 0;
         };
     }
 }
@@ -1,6 +1,8 @@
 #include "square_reader_writer.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
 #include "../square.hpp"
+#include "scanner.hpp"
 
 using namespace std;
 using namespace Drawing;
@@ -10,6 +12,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Square>(), &make_unique<SquareReaderWriter>);
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Square, SquareReaderWriter>();
 }
 
 void SquareReaderWriter::read(Shape& shp, istream& in)
@@ -31,3 +35,35 @@ void SquareReaderWriter::write(const Shape& shp, ostream& out)
 
     out << Square::id << " " << square.coord() << " " << square.size() << endl;
 }
+
+void SquareReaderWriter::read(Shape& shp, std::string_view& in)
+{
+    Square& sqr = static_cast<Square&>(shp);
+
+    sqr.set_coord(Scan::point(in));
+    sqr.set_size(Scan::integer(in));
+}
+
+void SquareReaderWriter::write(const Shape& shp, OutputBuffer& out)
+{
+    const Square& square = static_cast<const Square&>(shp);
+
+    out << Square::id << ' ' << square.coord() << ' ' << square.size() << '\n';
+}
+
+void SquareReaderWriter::read(Shape& shp, const Binary::ShapeRecord& record, std::string_view /*strings*/)
+{
+    Square& sqr = static_cast<Square&>(shp);
+
+    sqr.set_coord(Point{record.x, record.y});
+    sqr.set_size(record.params[0]);
+}
+
+void SquareReaderWriter::write(const Shape& shp, Binary::ShapeRecord& record, std::string& /*strings*/)
+{
+    const Square& square = static_cast<const Square&>(shp);
+
+    record.x = square.coord().x;
+    record.y = square.coord().y;
+    record.params = {square.size(), 0, 0};
+}
@@ -1,5 +1,7 @@
 #include "text_reader_writer.hpp"
 #include "../shape_factories.hpp"
+#include "../shape_type_registry.hpp"
+#include "scanner.hpp"
 #include "../text.hpp"
 
 using namespace std;
@@ -10,6 +12,8 @@ namespace
 {
     bool is_registered = SingletonShapeRWFactory::instance()
                              .register_creator(make_type_index<Text>(), [] { return make_unique<TextReaderWriter>(); });
+
+    bool is_type_registered = SingletonShapeTypeRegistry::instance().register_type<Text, TextReaderWriter>();
 }
 
 void Drawing::IO::TextReaderWriter::read(Drawing::Shape& shp, std::istream& in)
@@ -22,7 +26,7 @@ void Drawing::IO::TextReaderWriter::read(Drawing::Shape& shp, std::istream& in)
     in >> pt >> str;
 
     text_paragraph.set_coord(pt);
-    text_paragraph.set_text(str.c_str());
+    text_paragraph.set_text(str);
 }
 
 void TextReaderWriter::write(const Shape& shp, ostream& out)
@@ -31,3 +35,45 @@ void TextReaderWriter::write(const Shape& shp, ostream& out)
 
     out << Text::id << " " << text.coord() << " " << text.text() << "\n";
 }
+
+void TextReaderWriter::read(Shape& shp, std::string_view& in)
+{
+    Text& text_paragraph = static_cast<Text&>(shp);
+
+    text_paragraph.set_coord(Scan::point(in));
+    text_paragraph.set_text(Scan::word(in));
+}
+
+void TextReaderWriter::write(const Shape& shp, OutputBuffer& out)
+{
+    const Text& text = static_cast<const Text&>(shp);
+
+    out << Text::id << ' ' << text.coord() << ' ' << text.text() << '\n';
+}
+
+void TextReaderWriter::read(Shape& shp, const Binary::ShapeRecord& record, std::string_view strings)
+{
+    Text& text_paragraph = static_cast<Text&>(shp);
+
+    // params: offset & length of the content in the string pool
+    auto offset = static_cast<std::uint32_t>(record.params[0]);
+    auto length = static_cast<std::uint32_t>(record.params[1]);
+
+    if (offset > strings.size() || length > strings.size() - offset)
+        throw std::runtime_error("Binary record out of string pool bounds");
+
+    text_paragraph.set_coord(Point{record.x, record.y});
+    text_paragraph.set_text(strings.substr(offset, length));
+}
+
+void TextReaderWriter::write(const Shape& shp, Binary::ShapeRecord& record, std::string& strings)
+{
+    const Text& text = static_cast<const Text&>(shp);
+    const std::string& content = text.text();
+
+    record.x = text.coord().x;
+    record.y = text.coord().y;
+    record.params = {Binary::pool_param(strings.size()), Binary::pool_param(content.size()), 0};
+
+    strings += content;
+}
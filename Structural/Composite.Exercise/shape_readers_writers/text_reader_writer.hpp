@@ -12,6 +12,10 @@ namespace Drawing
         public:
             void read(Shape& shp, std::istream& in) override;
             void write(const Shape& shp, std::ostream& out) override;
+            void read(Shape& shp, std::string_view& in) override;
+            void write(const Shape& shp, OutputBuffer& out) override;
+            void read(Shape& shp, const Binary::ShapeRecord& record, std::string_view strings) override;
+            void write(const Shape& shp, Binary::ShapeRecord& record, std::string& strings) override;
         };
     }
 }
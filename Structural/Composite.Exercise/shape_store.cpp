@@ -0,0 +1,191 @@
+#include "shape_store.hpp"
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "square.hpp"
+#include "text.hpp"
+
+#include <stdexcept>
+#include <typeinfo>
+
+using namespace std;
+using namespace Drawing;
+
+namespace
+{
+    void translate(vector<int>& values, int delta)
+    {
+        for (int& value : values)
+            value += delta;
+    }
+
+    void translate(ShapeStore::Columns& columns, int dx, int dy)
+    {
+        translate(columns.x, dx);
+        translate(columns.y, dy);
+    }
+}
+
+uint32_t ShapeStore::push_entry(Kind kind, Columns& columns, int x, int y)
+{
+    const auto index = static_cast<uint32_t>(columns.size());
+
+    columns.x.push_back(x);
+    columns.y.push_back(y);
+    columns.position.push_back(static_cast<uint32_t>(order_.size()));
+    order_.push_back(Entry{kind, index});
+
+    return index;
+}
+
+void ShapeStore::add_rectangle(int x, int y, int width, int height)
+{
+    push_entry(Kind::rectangle, rectangles_, x, y);
+    rectangles_.width.push_back(width);
+    rectangles_.height.push_back(height);
+}
+
+void ShapeStore::add_square(int x, int y, int size)
+{
+    push_entry(Kind::square, squares_, x, y);
+    squares_.side.push_back(size);
+}
+
+void ShapeStore::add_circle(int x, int y, int radius)
+{
+    push_entry(Kind::circle, circles_, x, y);
+    circles_.radius.push_back(radius);
+}
+
+void ShapeStore::add_text(int x, int y, string text)
+{
+    push_entry(Kind::text, texts_, x, y);
+    texts_.text.push_back(std::move(text));
+}
+
+ShapeStore ShapeStore::import_from(const GraphicsDoc& doc)
+{
+    ShapeStore store;
+
+    for (const auto& shp : doc.shapes())
+    {
+        const type_info& type = typeid(*shp);
+
+        if (type == typeid(Rectangle))
+        {
+            const auto& rect = static_cast<const Rectangle&>(*shp);
+            store.add_rectangle(rect.coord().x, rect.coord().y, rect.width(), rect.height());
+        }
+        else if (type == typeid(Square))
+        {
+            const auto& square = static_cast<const Square&>(*shp);
+            store.add_square(square.coord().x, square.coord().y, square.size());
+        }
+        else if (type == typeid(Circle))
+        {
+            const auto& circle = static_cast<const Circle&>(*shp);
+            store.add_circle(circle.coord().x, circle.coord().y, circle.radius());
+        }
+        else if (type == typeid(Text))
+        {
+            const auto& text = static_cast<const Text&>(*shp);
+            store.add_text(text.coord().x, text.coord().y, text.text());
+        }
+        else
+            throw invalid_argument("ShapeStore: unsupported shape type "s + type.name());
+    }
+
+    return store;
+}
+
+void ShapeStore::export_to(GraphicsDoc& doc) const
+{
+    auto* resource = doc.memory_resource();
+
+    for (const auto& entry : order_)
+    {
+        const auto i = entry.index;
+
+        switch (entry.kind)
+        {
+        case Kind::rectangle:
+            doc.add(make_shape<Rectangle>(resource, rectangles_.x[i], rectangles_.y[i], rectangles_.width[i], rectangles_.height[i]));
+            break;
+        case Kind::square:
+            doc.add(make_shape<Square>(resource, squares_.x[i], squares_.y[i], squares_.side[i]));
+            break;
+        case Kind::circle:
+            doc.add(make_shape<Circle>(resource, circles_.x[i], circles_.y[i], circles_.radius[i]));
+            break;
+        case Kind::text:
+            doc.add(make_shape<Text>(resource, texts_.x[i], texts_.y[i], texts_.text[i]));
+            break;
+        }
+    }
+}
+
+void ShapeStore::translate_all(int dx, int dy)
+{
+    translate(rectangles_, dx, dy);
+    translate(squares_, dx, dy);
+    translate(circles_, dx, dy);
+    translate(texts_, dx, dy);
+}
+
+vector<BoundingBox> ShapeStore::bounding_boxes() const
+{
+    vector<BoundingBox> boxes(size());
+
+    for (size_t i = 0; i < rectangles_.size(); ++i)
+    {
+        const int x = rectangles_.x[i], y = rectangles_.y[i];
+        boxes[rectangles_.position[i]] = {x, y, x + rectangles_.width[i], y + rectangles_.height[i]};
+    }
+
+    for (size_t i = 0; i < squares_.size(); ++i)
+    {
+        const int x = squares_.x[i], y = squares_.y[i];
+        boxes[squares_.position[i]] = {x, y, x + squares_.side[i], y + squares_.side[i]};
+    }
+
+    for (size_t i = 0; i < circles_.size(); ++i)
+    {
+        const int x = circles_.x[i], y = circles_.y[i], r = circles_.radius[i];
+        boxes[circles_.position[i]] = {x - r, y - r, x + r, y + r};
+    }
+
+    for (size_t i = 0; i < texts_.size(); ++i)
+    {
+        const int x = texts_.x[i], y = texts_.y[i];
+        const int width = static_cast<int>(texts_.text[i].size()) * Text::glyph_width;
+        boxes[texts_.position[i]] = {x, y, x + width, y + Text::glyph_height};
+    }
+
+    return boxes;
+}
+
+void ShapeStore::render(RenderSink& sink) const
+{
+    // drawing order matters for overlapping shapes - walk the document order
+    for (const auto& entry : order_)
+    {
+        const auto i = entry.index;
+
+        switch (entry.kind)
+        {
+        case Kind::rectangle:
+            sink.draw_rectangle({rectangles_.x[i], rectangles_.y[i]}, rectangles_.width[i], rectangles_.height[i]);
+            break;
+        case Kind::square:
+            sink.draw_rectangle({squares_.x[i], squares_.y[i]}, squares_.side[i], squares_.side[i]);
+            break;
+        case Kind::circle:
+            sink.draw_circle({circles_.x[i], circles_.y[i]}, circles_.radius[i]);
+            break;
+        case Kind::text:
+            sink.draw_text({texts_.x[i], texts_.y[i]}, texts_.text[i]);
+            break;
+        }
+    }
+
+    sink.flush();
+}
@@ -0,0 +1,123 @@
+#ifndef SHAPE_STORE_HPP
+#define SHAPE_STORE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bounding_box.hpp"
+#include "graphics_doc.hpp"
+#include "render_sink.hpp"
+
+namespace Drawing
+{
+    // Data-oriented storage of the built-in shapes: every concrete type keeps its
+    // fields in separate columns (struct of arrays), so bulk operations run as plain
+    // per-type loops over contiguous ints instead of a virtual call per heap object.
+    class ShapeStore
+    {
+    public:
+        enum class Kind : std::uint8_t
+        {
+            rectangle,
+            square,
+            circle,
+            text
+        };
+
+        struct Columns
+        {
+            std::vector<int> x;
+            std::vector<int> y;
+            std::vector<std::uint32_t> position; // index in document order
+
+            std::size_t size() const
+            {
+                return x.size();
+            }
+        };
+
+        struct RectangleColumns : Columns
+        {
+            std::vector<int> width;
+            std::vector<int> height;
+        };
+
+        struct SquareColumns : Columns
+        {
+            std::vector<int> side;
+        };
+
+        struct CircleColumns : Columns
+        {
+            std::vector<int> radius;
+        };
+
+        struct TextColumns : Columns
+        {
+            std::vector<std::string> text;
+        };
+
+        // builds a store from a document - throws std::invalid_argument for shapes
+        // other than Rectangle, Square, Circle and Text
+        static ShapeStore import_from(const GraphicsDoc& doc);
+
+        // appends the shapes (in document order) to the document
+        void export_to(GraphicsDoc& doc) const;
+
+        void add_rectangle(int x, int y, int width, int height);
+        void add_square(int x, int y, int size);
+        void add_circle(int x, int y, int radius);
+        void add_text(int x, int y, std::string text);
+
+        std::size_t size() const
+        {
+            return order_.size();
+        }
+
+        void translate_all(int dx, int dy);
+
+        // boxes in document order
+        std::vector<BoundingBox> bounding_boxes() const;
+
+        // same primitives as drawing every shape of the document, in document order
+        void render(RenderSink& sink) const;
+
+        const RectangleColumns& rectangles() const
+        {
+            return rectangles_;
+        }
+
+        const SquareColumns& squares() const
+        {
+            return squares_;
+        }
+
+        const CircleColumns& circles() const
+        {
+            return circles_;
+        }
+
+        const TextColumns& texts() const
+        {
+            return texts_;
+        }
+
+    private:
+        struct Entry
+        {
+            Kind kind;
+            std::uint32_t index; // row in the columns of the kind
+        };
+
+        RectangleColumns rectangles_;
+        SquareColumns squares_;
+        CircleColumns circles_;
+        TextColumns texts_;
+        std::vector<Entry> order_;
+
+        std::uint32_t push_entry(Kind kind, Columns& columns, int x, int y);
+    };
+}
+
+#endif // SHAPE_STORE_HPP
@@ -0,0 +1,91 @@
+#ifndef SHAPE_TYPE_REGISTRY_HPP
+#define SHAPE_TYPE_REGISTRY_HPP
+
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "shape.hpp"
+#include "shape_readers_writers/shape_reader_writer.hpp"
+#include "singleton.hpp"
+
+namespace Drawing
+{
+    // everything needed to create, copy and serialize shapes of one type
+    struct ShapeTypeInfo
+    {
+        std::string id;
+        std::type_index type;
+        std::unique_ptr<Shape> (*create)();
+        ShapePtr (*create_in)(std::pmr::memory_resource* resource);
+        std::unique_ptr<Shape> (*clone)(const Shape&);
+        std::size_t size;
+        std::size_t alignment;
+        std::unique_ptr<IO::ShapeReaderWriter> shape_rw; // stateless - shared by all shapes of the type
+    };
+
+    class ShapeTypeRegistry
+    {
+        std::vector<std::unique_ptr<ShapeTypeInfo>> types_;
+        std::map<std::string, const ShapeTypeInfo*, std::less<>> types_by_id_;
+        std::unordered_map<std::type_index, const ShapeTypeInfo*> types_by_type_;
+
+    public:
+        template <typename ShapeType, typename ShapeRWType>
+        bool register_type()
+        {
+            auto type_info = std::make_unique<ShapeTypeInfo>(ShapeTypeInfo{
+                ShapeType::id,
+                std::type_index(typeid(ShapeType)),
+                []() -> std::unique_ptr<Shape> { return std::make_unique<ShapeType>(); },
+                [](std::pmr::memory_resource* resource) { return make_shape<ShapeType>(resource); },
+                [](const Shape& shp) -> std::unique_ptr<Shape> { return std::make_unique<ShapeType>(static_cast<const ShapeType&>(shp)); },
+                sizeof(ShapeType),
+                alignof(ShapeType),
+                std::make_unique<ShapeRWType>()});
+
+            if (types_by_id_.count(type_info->id) || types_by_type_.count(type_info->type))
+                return false;
+
+            types_by_id_.emplace(type_info->id, type_info.get());
+            types_by_type_.emplace(type_info->type, type_info.get());
+            types_.push_back(std::move(type_info));
+
+            return true;
+        }
+
+        const ShapeTypeInfo& find(std::string_view id) const
+        {
+            auto pos = types_by_id_.find(id);
+
+            if (pos == types_by_id_.end())
+                throw std::out_of_range("Unknown shape id: " + std::string(id));
+
+            return *pos->second;
+        }
+
+        const ShapeTypeInfo& find(std::type_index type) const
+        {
+            auto pos = types_by_type_.find(type);
+
+            if (pos == types_by_type_.end())
+                throw std::out_of_range(std::string("Unregistered shape type: ") + type.name());
+
+            return *pos->second;
+        }
+
+        const ShapeTypeInfo& find(const Shape& shp) const
+        {
+            return find(std::type_index(typeid(shp)));
+        }
+    };
+
+    using SingletonShapeTypeRegistry = SingletonHolder<ShapeTypeRegistry>;
+}
+
+#endif // SHAPE_TYPE_REGISTRY_HPP
@@ -0,0 +1,70 @@
+#include "shape_variant.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+using namespace std;
+using namespace Drawing;
+
+namespace
+{
+    using Creator = ShapeVariant (*)();
+
+    template <size_t... Indexes>
+    constexpr array<Creator, sizeof...(Indexes)> make_creators(index_sequence<Indexes...>)
+    {
+        return {[]() -> ShapeVariant { return ShapeVariant{in_place_index<Indexes>}; }...};
+    }
+
+    constexpr auto creators = make_creators(make_index_sequence<variant_size_v<ShapeVariant>>{});
+
+    template <typename Type>
+    bool copy_if_type(const Shape& shp, ShapeVariant& result)
+    {
+        if (typeid(shp) != typeid(Type))
+            return false;
+
+        result.emplace<Type>(static_cast<const Type&>(shp));
+
+        return true;
+    }
+
+    template <typename... Types>
+    bool copy_alternative(const Shape& shp, ShapeVariant& result, TypeList<Types...>)
+    {
+        return (copy_if_type<Types>(shp, result) || ...);
+    }
+}
+
+ShapeVariant Drawing::make_shape_variant(string_view id)
+{
+    const int index = StaticShapeFactory::index_of(id);
+
+    if (index == -1)
+        throw out_of_range("Unknown shape id: " + string(id));
+
+    return creators[index]();
+}
+
+ShapeVariant Drawing::to_variant(const Shape& shp)
+{
+    ShapeVariant result;
+
+    if (!copy_alternative(shp, result, BuiltInShapes{}))
+        throw invalid_argument(string("Not a built-in shape: ") + typeid(shp).name());
+
+    return result;
+}
+
+ShapePtr Drawing::to_shape(const ShapeVariant& shp, pmr::memory_resource* resource)
+{
+    return visit(
+        [resource](const auto& alternative) -> ShapePtr {
+            using Type = decay_t<decltype(alternative)>;
+            return make_shape<Type>(resource, alternative);
+        },
+        shp);
+}
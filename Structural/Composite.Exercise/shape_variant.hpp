@@ -0,0 +1,83 @@
+#ifndef SHAPE_VARIANT_HPP
+#define SHAPE_VARIANT_HPP
+
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include "static_shape_factory.hpp"
+
+namespace Drawing
+{
+    namespace Details
+    {
+        template <typename Types>
+        struct VariantOf;
+
+        template <typename... Types>
+        struct VariantOf<TypeList<Types...>>
+        {
+            using type = std::variant<Types...>;
+        };
+    }
+
+    // Built-in shapes stored by value. Alternatives are in the order of StaticShapeFactory,
+    // so StaticShapeFactory::index_of(id) is also the index of the alternative.
+    using ShapeVariant = Details::VariantOf<BuiltInShapes>::type;
+
+    // Members of the alternative are called qualified with its type - dispatch is the jump
+    // table of std::visit, no virtual call is made
+
+    inline void draw(const ShapeVariant& shp, RenderSink& sink)
+    {
+        std::visit(
+            [&sink](const auto& alternative) {
+                using Type = std::decay_t<decltype(alternative)>;
+                alternative.Type::draw(sink);
+            },
+            shp);
+    }
+
+    inline void move(ShapeVariant& shp, int dx, int dy)
+    {
+        std::visit(
+            [dx, dy](auto& alternative) {
+                using Type = std::decay_t<decltype(alternative)>;
+                alternative.Type::move(dx, dy);
+            },
+            shp);
+    }
+
+    inline BoundingBox bounding_box(const ShapeVariant& shp)
+    {
+        return std::visit(
+            [](const auto& alternative) {
+                using Type = std::decay_t<decltype(alternative)>;
+                return alternative.Type::bounding_box();
+            },
+            shp);
+    }
+
+    // the alternative through the virtual interface - e.g. for ShapeReaderWriter
+    inline Shape& as_shape(ShapeVariant& shp)
+    {
+        return std::visit([](Shape& alternative) -> Shape& { return alternative; }, shp);
+    }
+
+    inline const Shape& as_shape(const ShapeVariant& shp)
+    {
+        return std::visit([](const Shape& alternative) -> const Shape& { return alternative; }, shp);
+    }
+
+    // default-constructed alternative - throws std::out_of_range for ids of other shapes
+    ShapeVariant make_shape_variant(std::string_view id);
+
+    // copy of a built-in shape - throws std::invalid_argument for other shapes (e.g. ShapeGroup)
+    ShapeVariant to_variant(const Shape& shp);
+
+    // copy as a polymorphic shape (on the heap when resource is nullptr)
+    ShapePtr to_shape(const ShapeVariant& shp, std::pmr::memory_resource* resource = nullptr);
+}
+
+#endif // SHAPE_VARIANT_HPP
@@ -0,0 +1,197 @@
+#include "spatial_index.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+using namespace Drawing;
+
+namespace
+{
+    // ids in a cell are kept sorted - pick() scans from the top-most item
+    void insert_id(vector<SpatialIndex::Id>& ids, SpatialIndex::Id id)
+    {
+        if (ids.empty() || ids.back() < id)
+            ids.push_back(id);
+        else
+            ids.insert(lower_bound(ids.begin(), ids.end(), id), id);
+    }
+
+    void erase_id(vector<SpatialIndex::Id>& ids, SpatialIndex::Id id)
+    {
+        auto pos = lower_bound(ids.begin(), ids.end(), id);
+        if (pos != ids.end() && *pos == id)
+            ids.erase(pos);
+    }
+}
+
+SpatialIndex::SpatialIndex(int cell_size)
+    : cell_size_{cell_size}
+{
+    if (cell_size_ <= 0)
+        throw invalid_argument("SpatialIndex: cell size must be positive");
+}
+
+int SpatialIndex::cell_of(int coord) const
+{
+    // rounds towards negative infinity
+    return coord >= 0 ? coord / cell_size_ : -((-(coord + 1)) / cell_size_) - 1;
+}
+
+SpatialIndex::CellRange SpatialIndex::cells_of(const BoundingBox& box) const
+{
+    return {cell_of(box.left), cell_of(box.top), cell_of(box.right), cell_of(box.bottom)};
+}
+
+void SpatialIndex::link(Id id)
+{
+    Item& item = items_[id];
+    const auto range = cells_of(item.box);
+
+    item.is_oversized = range.count() > max_cells_per_item;
+
+    if (item.is_oversized)
+    {
+        insert_id(oversized_, id);
+        return;
+    }
+
+    for (int cx = range.first_x; cx <= range.last_x; ++cx)
+        for (int cy = range.first_y; cy <= range.last_y; ++cy)
+            insert_id(cells_[cell_key(cx, cy)], id);
+}
+
+void SpatialIndex::unlink(Id id)
+{
+    const Item& item = items_[id];
+
+    if (item.is_oversized)
+    {
+        erase_id(oversized_, id);
+        return;
+    }
+
+    const auto range = cells_of(item.box);
+
+    for (int cx = range.first_x; cx <= range.last_x; ++cx)
+        for (int cy = range.first_y; cy <= range.last_y; ++cy)
+        {
+            auto cell = cells_.find(cell_key(cx, cy));
+            erase_id(cell->second, id);
+
+            if (cell->second.empty())
+                cells_.erase(cell);
+        }
+}
+
+void SpatialIndex::insert(Id id, const BoundingBox& box)
+{
+    if (contains(id))
+        throw invalid_argument("SpatialIndex: id already indexed");
+
+    if (id >= items_.size())
+        items_.resize(id + 1);
+
+    items_[id].box = box;
+    items_[id].is_indexed = true;
+    link(id);
+}
+
+void SpatialIndex::update(Id id, const BoundingBox& box)
+{
+    if (!contains(id))
+        throw out_of_range("SpatialIndex: id not indexed");
+
+    // cheap path - the box still covers the same cells
+    if (!items_[id].is_oversized)
+    {
+        const auto old_range = cells_of(items_[id].box);
+        const auto new_range = cells_of(box);
+
+        if (old_range.first_x == new_range.first_x && old_range.first_y == new_range.first_y
+            && old_range.last_x == new_range.last_x && old_range.last_y == new_range.last_y)
+        {
+            items_[id].box = box;
+            return;
+        }
+    }
+
+    unlink(id);
+    items_[id].box = box;
+    link(id);
+}
+
+void SpatialIndex::remove(Id id)
+{
+    if (!contains(id))
+        throw out_of_range("SpatialIndex: id not indexed");
+
+    unlink(id);
+    items_[id].is_indexed = false;
+}
+
+void SpatialIndex::clear()
+{
+    items_.clear();
+    cells_.clear();
+    oversized_.clear();
+}
+
+vector<SpatialIndex::Id> SpatialIndex::query(const BoundingBox& area) const
+{
+    vector<Id> result;
+
+    auto collect = [&](const vector<Id>& ids) {
+        for (Id id : ids)
+            if (intersects(items_[id].box, area))
+                result.push_back(id);
+    };
+
+    const auto range = cells_of(area);
+
+    if (range.count() <= cells_.size())
+    {
+        for (int cx = range.first_x; cx <= range.last_x; ++cx)
+            for (int cy = range.first_y; cy <= range.last_y; ++cy)
+            {
+                auto cell = cells_.find(cell_key(cx, cy));
+                if (cell != cells_.end())
+                    collect(cell->second);
+            }
+    }
+    else // the area covers more cells than are occupied
+    {
+        for (const auto& [key, ids] : cells_)
+            collect(ids);
+    }
+
+    collect(oversized_);
+
+    // items spanning several cells are found more than once
+    sort(result.begin(), result.end());
+    result.erase(unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+optional<SpatialIndex::Id> SpatialIndex::pick(const Point& pt) const
+{
+    optional<Id> result;
+
+    auto check = [&](const vector<Id>& ids) {
+        for (auto it = ids.rbegin(); it != ids.rend() && (!result || *it > *result); ++it)
+            if (Drawing::contains(items_[*it].box, pt))
+            {
+                result = *it;
+                return;
+            }
+    };
+
+    auto cell = cells_.find(cell_key(cell_of(pt.x), cell_of(pt.y)));
+    if (cell != cells_.end())
+        check(cell->second);
+
+    check(oversized_);
+
+    return result;
+}
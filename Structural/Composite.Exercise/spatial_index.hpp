@@ -0,0 +1,99 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "bounding_box.hpp"
+
+namespace Drawing
+{
+    // Uniform grid over bounding boxes of items identified by dense ids (e.g. positions
+    // in a document). Every item is listed in each cell its box overlaps; items spanning
+    // too many cells are kept on a separate list checked by every query.
+    class SpatialIndex
+    {
+    public:
+        using Id = std::size_t;
+
+        static constexpr int default_cell_size = 256;
+        static constexpr std::size_t max_cells_per_item = 64;
+
+        explicit SpatialIndex(int cell_size = default_cell_size);
+
+        void insert(Id id, const BoundingBox& box);
+        void update(Id id, const BoundingBox& box);
+        void remove(Id id);
+        void clear();
+
+        bool contains(Id id) const
+        {
+            return id < items_.size() && items_[id].is_indexed;
+        }
+
+        // ids of items whose boxes intersect the area - in ascending order
+        std::vector<Id> query(const BoundingBox& area) const;
+
+        // item with the greatest id whose box contains the point
+        std::optional<Id> pick(const Point& pt) const;
+
+        // item with the greatest rank(id) whose box contains the point (e.g. ranked by z-order)
+        template <typename Rank>
+        std::optional<Id> pick(const Point& pt, Rank rank) const
+        {
+            std::optional<Id> result;
+
+            auto check = [&](const std::vector<Id>& ids) {
+                for (Id id : ids)
+                    if (Drawing::contains(items_[id].box, pt) && (!result || rank(id) > rank(*result)))
+                        result = id;
+            };
+
+            auto cell = cells_.find(cell_key(cell_of(pt.x), cell_of(pt.y)));
+            if (cell != cells_.end())
+                check(cell->second);
+
+            check(oversized_);
+
+            return result;
+        }
+
+    private:
+        struct Item
+        {
+            BoundingBox box;
+            bool is_indexed = false;
+            bool is_oversized = false;
+        };
+
+        struct CellRange
+        {
+            int first_x, first_y, last_x, last_y;
+
+            std::size_t count() const
+            {
+                return static_cast<std::size_t>(last_x - first_x + 1) * static_cast<std::size_t>(last_y - first_y + 1);
+            }
+        };
+
+        int cell_size_;
+        std::vector<Item> items_;
+        std::unordered_map<std::uint64_t, std::vector<Id>> cells_;
+        std::vector<Id> oversized_;
+
+        int cell_of(int coord) const;
+        CellRange cells_of(const BoundingBox& box) const;
+
+        static std::uint64_t cell_key(int cell_x, int cell_y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell_x)) << 32) | static_cast<std::uint32_t>(cell_y);
+        }
+
+        void link(Id id);
+        void unlink(Id id);
+    };
+}
+
+#endif // SPATIAL_INDEX_HPP
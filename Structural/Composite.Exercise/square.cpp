@@ -43,7 +43,12 @@ void Square::set_size(int size)
     assert(rect_.width() == rect_.height());
 }
 
-void Square::draw() const
+BoundingBox Square::bounding_box() const
 {
-    rect_.draw();
+    return rect_.bounding_box();
+}
+
+void Square::draw(RenderSink& sink) const
+{
+    rect_.draw(sink);
 }
@@ -23,7 +23,9 @@ namespace Drawing
 
         void set_size(int size);
 
-        void draw() const override;
+        void draw(RenderSink& sink) const override;
+
+        BoundingBox bounding_box() const override;
 
         void move(int dx, int dy) override;
     };
@@ -0,0 +1,140 @@
+#ifndef STATIC_FACTORY_HPP
+#define STATIC_FACTORY_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+template <typename... Types>
+struct TypeList
+{
+};
+
+namespace Details
+{
+    // FNV-1a with a seed mixed into the offset basis, followed by a murmur3 finalizer
+    // (low bits of plain FNV-1a depend only on the low bits of the seed)
+    constexpr std::uint32_t hash(std::string_view text, std::uint32_t seed)
+    {
+        std::uint32_t h = 2166136261u ^ seed;
+        for (char c : text)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+
+        return h;
+    }
+
+    constexpr std::size_t next_power_of_2(std::size_t n)
+    {
+        std::size_t result = 1;
+        while (result < n)
+            result *= 2;
+
+        return result;
+    }
+}
+
+// Factory over a closed, compile-time list of product types. Each type provides a
+// static `id`. A perfect hash over the ids is computed at compile time, so lookups
+// by std::string_view neither allocate nor probe, and creators are called directly.
+template <typename ProductType, typename ProductList>
+class StaticFactory;
+
+template <typename ProductType, typename... ProductTypes>
+class StaticFactory<ProductType, TypeList<ProductTypes...>>
+{
+    static_assert(sizeof...(ProductTypes) > 0, "StaticFactory requires at least one product type");
+
+    static constexpr std::size_t type_count = sizeof...(ProductTypes);
+    static constexpr std::size_t table_size = Details::next_power_of_2(2 * type_count);
+    static constexpr std::size_t no_type = type_count;
+    static constexpr std::uint32_t max_seed = 100'000;
+
+    static constexpr std::array<std::string_view, type_count> ids_ = {std::string_view{ProductTypes::id}...};
+
+    static constexpr std::size_t slot_of(std::string_view id, std::uint32_t seed)
+    {
+        return Details::hash(id, seed) & (table_size - 1);
+    }
+
+    static constexpr std::uint32_t find_seed()
+    {
+        for (std::uint32_t seed = 0; seed < max_seed; ++seed)
+        {
+            std::array<bool, table_size> is_used{};
+            bool is_perfect = true;
+
+            for (std::size_t i = 0; i < type_count && is_perfect; ++i)
+            {
+                auto slot = slot_of(ids_[i], seed);
+                is_perfect = !is_used[slot];
+                is_used[slot] = true;
+            }
+
+            if (is_perfect)
+                return seed;
+        }
+
+        return max_seed;
+    }
+
+    static constexpr std::uint32_t seed_ = find_seed();
+    static_assert(seed_ != max_seed, "No perfect hash found - are the ids unique?");
+
+    static constexpr std::array<std::size_t, table_size> build_slots()
+    {
+        std::array<std::size_t, table_size> slots{};
+        for (auto& index : slots)
+            index = no_type;
+
+        for (std::size_t i = 0; i < type_count; ++i)
+            slots[slot_of(ids_[i], seed_)] = i;
+
+        return slots;
+    }
+
+    static constexpr std::array<std::size_t, table_size> slots_ = build_slots();
+
+    template <typename T>
+    static std::unique_ptr<ProductType> create_product()
+    {
+        return std::make_unique<T>();
+    }
+
+    using Creator = std::unique_ptr<ProductType> (*)();
+
+    static constexpr std::array<Creator, type_count> creators_ = {&create_product<ProductTypes>...};
+
+public:
+    // index of the type in ProductTypes... or -1 when the id is unknown
+    static constexpr int index_of(std::string_view id)
+    {
+        const std::size_t index = slots_[slot_of(id, seed_)];
+
+        return (index != no_type && ids_[index] == id) ? static_cast<int>(index) : -1;
+    }
+
+    static constexpr bool contains(std::string_view id)
+    {
+        return index_of(id) != -1;
+    }
+
+    // returns nullptr when the id is unknown
+    static std::unique_ptr<ProductType> create(std::string_view id)
+    {
+        const int index = index_of(id);
+
+        return index != -1 ? creators_[index]() : nullptr;
+    }
+};
+
+#endif // STATIC_FACTORY_HPP
@@ -0,0 +1,17 @@
+#ifndef STATIC_SHAPE_FACTORY_HPP
+#define STATIC_SHAPE_FACTORY_HPP
+
+#include "circle.hpp"
+#include "rectangle.hpp"
+#include "square.hpp"
+#include "static_factory.hpp"
+#include "text.hpp"
+
+namespace Drawing
+{
+    // built-in shapes - types from plugins are still registered in ShapeFactory
+    using BuiltInShapes = TypeList<Rectangle, Square, Circle, Text>;
+    using StaticShapeFactory = StaticFactory<Shape, BuiltInShapes>;
+}
+
+#endif // STATIC_SHAPE_FACTORY_HPP
@@ -0,0 +1,93 @@
+#define CATCH_CONFIG_MAIN
+
+#include "catch.hpp"
+#include <memory_resource>
+#include <vector>
+
+#include "circle.hpp"
+#include "graphics_doc.hpp"
+#include "rectangle.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+namespace
+{
+    // counts bytes the arena requests from its upstream resource
+    class CountingResource : public pmr::memory_resource
+    {
+        size_t allocated_bytes_ = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            allocated_bytes_ += bytes;
+            return pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* raw_mem, size_t bytes, size_t alignment) override
+        {
+            pmr::new_delete_resource()->deallocate(raw_mem, bytes, alignment);
+        }
+
+        bool do_is_equal(const pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        size_t allocated_bytes() const
+        {
+            return allocated_bytes_;
+        }
+    };
+
+    // the arena takes the default resource as its upstream when the document is created
+    class DefaultResourceScope
+    {
+        pmr::memory_resource* previous_;
+
+    public:
+        explicit DefaultResourceScope(pmr::memory_resource* resource)
+            : previous_{pmr::set_default_resource(resource)}
+        {
+        }
+
+        DefaultResourceScope(const DefaultResourceScope&) = delete;
+        DefaultResourceScope& operator=(const DefaultResourceScope&) = delete;
+
+        ~DefaultResourceScope()
+        {
+            pmr::set_default_resource(previous_);
+        }
+    };
+}
+
+TEST_CASE("Arena document - adding and removing shapes reuses the arena", "[GraphicsDoc][arena]")
+{
+    CountingResource upstream;
+    DefaultResourceScope scope{&upstream};
+
+    GraphicsDoc doc{SingletonShapeTypeRegistry::instance(), ShapeStorage::arena};
+
+    auto edit = [&doc] {
+        vector<ShapeHandle> handles;
+
+        for (int i = 0; i < 1'000; ++i)
+        {
+            handles.push_back(doc.add(make_shape<Circle>(doc.memory_resource(), i, i, 10)));
+            handles.push_back(doc.add(make_shape<Rectangle>(doc.memory_resource(), i, i, 10, 20)));
+        }
+
+        for (auto handle : handles)
+            REQUIRE(doc.remove(handle));
+    };
+
+    edit(); // warm-up
+    const size_t allocated_bytes = upstream.allocated_bytes();
+
+    for (int i = 0; i < 10; ++i)
+        edit();
+
+    REQUIRE(doc.size() == 0);
+    REQUIRE(upstream.allocated_bytes() == allocated_bytes);
+}
@@ -0,0 +1,53 @@
+#include "catch.hpp"
+
+#include "circle.hpp"
+#include "shape_group.hpp"
+
+using namespace std;
+using namespace Drawing;
+
+TEST_CASE("ShapeGroup - open nested group spans the members added so far", "[ShapeGroup]")
+{
+    ShapeGroup group;
+    group.begin_group();
+    group.add(make_shape<Circle>(nullptr, 100, 100, 10));
+    group.begin_group();
+    group.add(make_shape<Circle>(nullptr, 200, 200, 10));
+
+    REQUIRE(group.size() == 1);
+    REQUIRE(group.subtree_size(0) == 4);
+    REQUIRE(group.subtree_size(2) == 2);
+    REQUIRE(group.member_count(0) == 2);
+    REQUIRE(group.bounding_box() == BoundingBox{90, 90, 210, 210});
+
+    group.move(1, 1);
+    REQUIRE(group.bounding_box() == BoundingBox{91, 91, 211, 211});
+
+    group.end_group();
+    group.add(make_shape<Circle>(nullptr, 0, 0, 10));
+    group.end_group();
+    group.add(make_shape<Circle>(nullptr, 500, 500, 10));
+
+    REQUIRE(group.size() == 2);
+    REQUIRE(group.subtree_size(0) == 5);
+    REQUIRE(group.member_count(0) == 3);
+    REQUIRE(group.bounding_box() == BoundingBox{-10, -10, 510, 510});
+}
+
+TEST_CASE("ShapeGroup - groups without leaf shapes have no bounds", "[ShapeGroup]")
+{
+    ShapeGroup group;
+    group.begin_group();
+    group.begin_group();
+    group.end_group();
+    group.end_group();
+
+    REQUIRE(group.is_empty());
+    REQUIRE(group.is_empty(0));
+
+    group.add(make_shape<Circle>(nullptr, 100, 100, 10));
+
+    REQUIRE_FALSE(group.is_empty());
+    REQUIRE(group.is_empty(0));
+    REQUIRE(group.bounding_box() == BoundingBox{90, 90, 110, 110});
+}
@@ -10,22 +10,29 @@ namespace
         Text::id, &make_unique<Text>);
 }
 
-Text::Text(int x, int y, const string& text)
-    : ShapeBase{x, y}, LegacyCode::Paragraph{text.c_str()}
+Text::Text(int x, int y, string_view text)
+    : ShapeBase{x, y}, text_{TextPool::instance().intern(text)}
 {
 }
 
-string Text::text() const
+void Text::set_text(string_view text)
 {
-    return get_paragraph();
+    text_ = TextPool::instance().intern(text);
 }
 
-void Text::set_text(const string& text)
+LegacyCode::Paragraph Text::paragraph() const
 {
-    set_paragraph(text.c_str());
+    return LegacyCode::Paragraph{text().substr(0, legacy_max_length).c_str()};
 }
 
-void Text::draw() const
+BoundingBox Text::bounding_box() const
 {
-    render_at(coord().x, coord().y);
+    const int width = static_cast<int>(text().size()) * glyph_width;
+
+    return {coord().x, coord().y, coord().x + width, coord().y + glyph_height};
+}
+
+void Text::draw(RenderSink& sink) const
+{
+    sink.draw_text(coord(), text());
 }
@@ -1,23 +1,47 @@
 #ifndef TEXT_HPP
 #define TEXT_HPP
 
+#include <string>
+#include <string_view>
+
 #include "paragraph.hpp"
 #include "shape.hpp"
+#include "text_pool.hpp"
 
 namespace Drawing
 {
-    class Text : public ShapeBase<Text>, private LegacyCode::Paragraph
+    // Object adapter of LegacyCode::Paragraph. The content is interned in the TextPool,
+    // so a Text holds just a handle of a label shared by all shapes with the same content;
+    // a Paragraph (with its 1 KiB buffer) is materialized only for legacy code.
+    class Text : public ShapeBase<Text>
     {
+        TextPool::Handle text_;
+
     public:
         static constexpr const char* id = "Text";
 
-        Text(int x = 0, int y = 0, const std::string& content = "");
+        // fixed-size glyph cell used for text extents
+        static constexpr int glyph_width = 8;
+        static constexpr int glyph_height = 16;
+
+        // longest content a LegacyCode::Paragraph can hold
+        static constexpr std::size_t legacy_max_length = 1023;
+
+        Text(int x = 0, int y = 0, std::string_view content = "");
+
+        const std::string& text() const
+        {
+            return text_.str();
+        }
+
+        void set_text(std::string_view text);
 
-        std::string text() const;
+        // content truncated to legacy_max_length
+        LegacyCode::Paragraph paragraph() const;
 
-        void set_text(const std::string& text);
+        void draw(RenderSink& sink) const override;
 
-        void draw() const override;
+        BoundingBox bounding_box() const override;
     };
 }
 
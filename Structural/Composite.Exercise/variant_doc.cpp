@@ -0,0 +1,118 @@
+#include "variant_doc.hpp"
+#include "mapped_file.hpp"
+#include "shape_readers_writers/scanner.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <typeindex>
+
+using namespace std;
+using namespace Drawing;
+using namespace Drawing::IO;
+
+namespace
+{
+    template <typename... Types>
+    array<ShapeReaderWriter*, sizeof...(Types)> find_shape_rws(const ShapeTypeRegistry& shape_types, TypeList<Types...>)
+    {
+        return {shape_types.find(type_index(typeid(Types))).shape_rw.get()...};
+    }
+
+    template <typename... Types>
+    vector<Binary::TypeEntry> make_type_table(TypeList<Types...>)
+    {
+        return {Binary::make_type_entry(Types::id)...};
+    }
+}
+
+VariantDoc::VariantDoc(const ShapeTypeRegistry& shape_types)
+    : shape_rws_{find_shape_rws(shape_types, BuiltInShapes{})}
+{
+}
+
+void VariantDoc::move(size_t index, int dx, int dy)
+{
+    Drawing::move(shapes_.at(index), dx, dy);
+}
+
+void VariantDoc::render(RenderSink& sink) const
+{
+    for (const auto& shp : shapes_)
+        draw(shp, sink);
+
+    sink.flush();
+}
+
+void VariantDoc::load(const string& filename)
+{
+    MappedFile file{filename};
+    string_view in = file.view();
+
+    for (auto shape_id = Scan::word(in); !shape_id.empty(); shape_id = Scan::word(in))
+    {
+        auto shape = make_shape_variant(shape_id);
+        shape_rws_[shape.index()]->read(as_shape(shape), in);
+
+        shapes_.push_back(std::move(shape)); // added only when the whole record was read
+    }
+}
+
+void VariantDoc::save(const string& filename) const
+{
+    ofstream file_out{filename};
+    OutputBuffer out{file_out};
+
+    for (const auto& shp : shapes_)
+        shape_rws_[shp.index()]->write(as_shape(shp), out);
+}
+
+void VariantDoc::load_binary(const string& filename)
+{
+    MappedFile file{filename};
+    const auto header = Binary::read_header(file.view());
+
+    // type tags are resolved to alternatives once per file
+    vector<ShapeVariant> prototypes;
+    prototypes.reserve(header.type_count);
+
+    for (uint64_t i = 0; i < header.type_count; ++i)
+        prototypes.push_back(make_shape_variant(Binary::type_id(header, file.view(), i)));
+
+    const string_view strings = file.view().substr(header.strings_offset, header.strings_size);
+
+    shapes_.reserve(shapes_.size() + header.record_count);
+
+    for (uint64_t i = 0; i < header.record_count; ++i)
+    {
+        const auto record = Binary::read_at<Binary::ShapeRecord>(file.view(), header.records_offset + i * header.record_size);
+
+        if (record.type_tag >= header.type_count)
+            throw runtime_error("Binary drawing: unknown type tag " + to_string(record.type_tag));
+
+        auto shape = prototypes[record.type_tag];
+        shape_rws_[shape.index()]->read(as_shape(shape), record, strings);
+
+        shapes_.push_back(std::move(shape));
+    }
+}
+
+void VariantDoc::save_binary(const string& filename) const
+{
+    // the type tag of a record is the index of the alternative
+    const auto type_table = make_type_table(BuiltInShapes{});
+
+    vector<Binary::ShapeRecord> records(shapes_.size());
+    string strings;
+
+    for (size_t i = 0; i < shapes_.size(); ++i)
+    {
+        records[i].type_tag = static_cast<uint32_t>(shapes_[i].index());
+        shape_rws_[shapes_[i].index()]->write(as_shape(shapes_[i]), records[i], strings);
+    }
+
+    ofstream file_out{filename, ios::binary};
+    Binary::write_drawing(file_out, type_table, records, strings);
+
+    if (!file_out)
+        throw runtime_error("Binary drawing: cannot write file " + filename);
+}
@@ -0,0 +1,51 @@
+#ifndef VARIANT_DOC_HPP
+#define VARIANT_DOC_HPP
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "shape_type_registry.hpp"
+#include "shape_variant.hpp"
+
+// Document of built-in shapes stored by value in one contiguous vector (no allocation and
+// no vtable dispatch per shape). Files are read and written with the ShapeReaderWriters
+// registered for the shapes, so they are interchangeable with GraphicsDoc files.
+class VariantDoc
+{
+    std::vector<Drawing::ShapeVariant> shapes_;
+    std::array<Drawing::IO::ShapeReaderWriter*, std::variant_size_v<Drawing::ShapeVariant>> shape_rws_; // by alternative
+
+public:
+    explicit VariantDoc(const Drawing::ShapeTypeRegistry& shape_types);
+
+    void add(Drawing::ShapeVariant shp)
+    {
+        shapes_.push_back(std::move(shp));
+    }
+
+    const std::vector<Drawing::ShapeVariant>& shapes() const
+    {
+        return shapes_;
+    }
+
+    std::size_t size() const
+    {
+        return shapes_.size();
+    }
+
+    void move(std::size_t index, int dx, int dy);
+
+    // draws all shapes and flushes the sink once
+    void render(Drawing::RenderSink& sink) const;
+
+    // text interchange format - throws std::out_of_range for shapes other than the built-in ones
+    void load(const std::string& filename);
+    void save(const std::string& filename) const;
+
+    // binary format - see shape_readers_writers/binary_format.hpp
+    void load_binary(const std::string& filename);
+    void save_binary(const std::string& filename) const;
+};
+
+#endif // VARIANT_DOC_HPP
@@ -0,0 +1,153 @@
+#ifndef TEXT_POOL_HPP
+#define TEXT_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Drawing
+{
+    // Interned, immutable strings shared by Text shapes - identical labels are stored once.
+    // Texts hold reference-counted handles: a string is released when its last handle goes away.
+    // Only interning takes the lock - copying a handle (e.g. cloning a Text) is an atomic increment.
+    class TextPool
+    {
+        struct Entry
+        {
+            std::string text;
+            std::atomic<std::size_t> ref_count{0};
+        };
+
+        mutable std::mutex mtx_;
+        std::unordered_map<std::string_view, std::unique_ptr<Entry>> entries_; // keys view Entry::text
+
+        void release(Entry* entry) noexcept
+        {
+            // the last reference is dropped under the lock, so intern() cannot revive an entry being erased
+            std::size_t count = entry->ref_count.load(std::memory_order_relaxed);
+            while (count > 1)
+            {
+                if (entry->ref_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel))
+                    return;
+            }
+
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            if (entry->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                entries_.erase(entry->text);
+        }
+
+    public:
+        // a handle of the empty string refers to no entry
+        class Handle
+        {
+            TextPool* pool_ = nullptr;
+            Entry* entry_ = nullptr;
+
+            Handle(TextPool* pool, Entry* entry) noexcept
+                : pool_{pool}, entry_{entry}
+            {
+            }
+
+            friend class TextPool;
+
+        public:
+            Handle() = default;
+
+            Handle(const Handle& other) noexcept
+                : pool_{other.pool_}, entry_{other.entry_}
+            {
+                if (entry_)
+                    entry_->ref_count.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            Handle(Handle&& other) noexcept
+                : pool_{std::exchange(other.pool_, nullptr)}, entry_{std::exchange(other.entry_, nullptr)}
+            {
+            }
+
+            Handle& operator=(Handle other) noexcept
+            {
+                std::swap(pool_, other.pool_);
+                std::swap(entry_, other.entry_);
+
+                return *this;
+            }
+
+            ~Handle()
+            {
+                if (entry_)
+                    pool_->release(entry_);
+            }
+
+            const std::string& str() const noexcept
+            {
+                static const std::string empty;
+
+                return entry_ ? entry_->text : empty;
+            }
+        };
+
+        TextPool() = default;
+        TextPool(const TextPool&) = delete;
+        TextPool& operator=(const TextPool&) = delete;
+
+        // never destroyed - texts in static objects may release their handles at any point of the exit
+        static TextPool& instance()
+        {
+            static TextPool* unique_instance = new TextPool;
+
+            return *unique_instance;
+        }
+
+        Handle intern(std::string_view text)
+        {
+            if (text.empty())
+                return Handle{};
+
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            auto pos = entries_.find(text);
+            if (pos == entries_.end())
+            {
+                auto entry = std::make_unique<Entry>();
+                entry->text = text;
+                pos = entries_.emplace(entry->text, std::move(entry)).first;
+            }
+
+            pos->second->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+            return Handle{this, pos->second.get()};
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            return entries_.size();
+        }
+
+        // approximate heap usage - hash nodes, entries and out-of-line string buffers
+        std::size_t memory_usage() const
+        {
+            std::lock_guard<std::mutex> lk{mtx_};
+
+            constexpr std::size_t node_overhead = sizeof(void*) + sizeof(std::size_t); // next, cached hash
+            const std::size_t sso_capacity = std::string{}.capacity();
+
+            std::size_t bytes = entries_.bucket_count() * sizeof(void*);
+            for (const auto& [text, entry] : entries_)
+                bytes += node_overhead + sizeof(std::string_view) + sizeof(std::unique_ptr<Entry>) + sizeof(Entry)
+                    + (entry->text.capacity() > sso_capacity ? entry->text.capacity() + 1 : 0);
+
+            return bytes;
+        }
+    };
+}
+
+#endif // TEXT_POOL_HPP